@@ -1,9 +1,25 @@
 #include "admin.h"
+#include "dates.h"
+#include "results.h"
+#include "pager.h"
+#include "querycache.h"
+#include "search.h"
+#include "shards.h"
+#include "selector.h"
+#include "table.h"
+#include "filemanager.h"
+#include "gradeslayout.h"
+#include "gradesession.h"
+#include "records.h"
+#include "transcripts.h"
+#include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <iomanip>
 
 Admin::Admin(int id, const std::string& username, const std::string& password, Database& db)
-    : User(id, username, password, Role::ADMIN), db(db) {}
+    : User(id, username, password, Role::ADMIN), db(db),
+      studentNames(db, "students"), courseNames(db, "courses") {}
 
 void Admin::showMenu() {
     int choice = 0;
@@ -15,6 +31,10 @@ void Admin::showMenu() {
         std::cout << "  [2] Gérer les cours\n";
         std::cout << "  [3] Gérer les notes\n";
         std::cout << "  [4] Gérer les utilisateurs\n";
+        std::cout << "  [5] Résultats de la promotion\n";
+        std::cout << "  [6] Outils\n";
+        std::cout << "  [7] Export / Import\n";
+        std::cout << "  [8] Rechercher (étudiants, cours)\n";
         std::cout << "  [0] Déconnexion\n";
         std::cout << "------------------------------\n";
         std::cout << "Choix : ";
@@ -46,12 +66,17 @@ void Admin::showMenu() {
             case 3: {
                 int sub = 0;
                 std::cout << "\n-- Notes --\n";
-                std::cout << "[1] Lister  [2] Ajouter  [3] Modifier  [4] Supprimer\nChoix : ";
+                std::cout << "[1] Lister  [2] Ajouter  [3] Modifier  [4] Supprimer\n"
+                          << "[5] Historique d'un étudiant  [6] Modifications récentes  "
+                             "[7] Notes par période\nChoix : ";
                 std::cin >> sub; std::cin.ignore();
                 if (sub == 1) listGrades();
                 else if (sub == 2) addGrade();
                 else if (sub == 3) updateGrade();
                 else if (sub == 4) deleteGrade();
+                else if (sub == 5) gradeHistory();
+                else if (sub == 6) recentGradeChanges();
+                else if (sub == 7) gradesByPeriod();
                 break;
             }
             case 4: {
@@ -64,6 +89,53 @@ void Admin::showMenu() {
                 else if (sub == 3) deleteUser();
                 break;
             }
+            case 5: {
+                int sub = 0;
+                std::cout << "\n-- Résultats --\n";
+                std::cout << "[1] Calculer (toute la promotion)  [2] Répartition des mentions  "
+                             "[3] Résultat d'un étudiant\n"
+                          << "[4] Relevés de notes (un fichier par étudiant)\nChoix : ";
+                std::cin >> sub; std::cin.ignore();
+                if (sub == 1) computeResults();
+                else if (sub == 2) showMentionSummary();
+                else if (sub == 3) showStudentResult();
+                else if (sub == 4) generateTranscripts();
+                break;
+            }
+            case 6: {
+                int sub = 0;
+                std::cout << "\n-- Outils --\n";
+                std::cout << "[1] Benchmark affichage (1M lignes)  [2] Disposition des notes (rowid / groupée)\n"
+                          << "[3] Benchmark disposition des notes (pages lues par étudiant)\n"
+                          << "[4] Répartir la base sur plusieurs fichiers (étudiants par ID)\n"
+                          << "[5] Cache des requêtes (activer / désactiver, statistiques)\n"
+                          << "[6] Purger le journal des changements (exports différentiels)\nChoix : ";
+                std::cin >> sub; std::cin.ignore();
+                if (sub == 1) benchmarkDisplay();
+                else if (sub == 2) changeGradesLayout();
+                else if (sub == 3) benchmarkLayout();
+                else if (sub == 4) shardDatabase();
+                else if (sub == 5) queryCache();
+                else if (sub == 6) FileManager(db).pruneChangeLogData(*this);
+                break;
+            }
+            case 7: {
+                int sub = 0;
+                std::cout << "\n-- Export / Import --\n";
+                std::cout << "[1] Exporter  [2] Importer  [3] Export parallèle (fichiers + manifeste)\n"
+                          << "[4] Export différentiel (depuis une génération)\n"
+                          << "[5] Synchroniser depuis un fichier (n'écrire que les différences)\nChoix : ";
+                std::cin >> sub; std::cin.ignore();
+                if (sub == 1) FileManager(db).exportData(*this);
+                else if (sub == 2) FileManager(db).importData(*this);
+                else if (sub == 3) FileManager(db).exportDataParallel(*this);
+                else if (sub == 4) FileManager(db).exportDeltaData(*this);
+                else if (sub == 5) FileManager(db).syncData(*this);
+                break;
+            }
+            case 8:
+                FullTextSearch(db).prompt();
+                break;
             case 0:
                 std::cout << "Déconnexion...\n";
                 break;
@@ -75,25 +147,72 @@ void Admin::showMenu() {
 
 // ─── ÉTUDIANTS ─────────────────────────────────────────────────────────────
 
+// Listes paginées : le CROSS JOIN force le parcours par idx_students_name
+static const KeysetQuery STUDENTS_PAGE = {
+    "SELECT s.id, s.name, s.email, s.birthdate FROM students s", "",
+    {"s.name", "s.id"}, {"name", "id"}};
+
+static const KeysetQuery GRADES_PAGE = {
+    "SELECT g.id, s.id AS sid, s.name AS student, c.name AS course, g.grade, "
+    + daySql("g.date_recorded") + " AS date_recorded "
+    "FROM students s "
+    "CROSS JOIN grades g ON g.student_id = s.id "
+    "JOIN courses  c ON g.course_id  = c.id", "",
+    {"s.name", "s.id", "c.name", "g.id"}, {"student", "sid", "course", "id"}, 2};
+
+// Historique des notes : jointures externes, l'étudiant ou le cours a pu être supprimé
+static const std::string GRADE_HISTORY_SELECT =
+    "SELECT h.id, h.grade_id, h.course_id, h.changed_at, "
+    + timeSql("h.changed_at") + " AS changed, "
+    "COALESCE(s.name, '(supprimé)') AS student, COALESCE(c.name, '(supprimé)') AS course, "
+    "CASE h.op WHEN 'I' THEN 'saisie' WHEN 'U' THEN 'modifiée' ELSE 'supprimée' END AS op, "
+    "COALESCE(h.old_grade, '-') AS old_grade, COALESCE(h.new_grade, '-') AS new_grade "
+    "FROM grade_history h "
+    "LEFT JOIN students s ON s.id = h.student_id "
+    "LEFT JOIN courses  c ON c.id = h.course_id";
+
+static const KeysetQuery USERS_PAGE = {
+    "SELECT id, username, role FROM users", "",
+    {"role", "username"}, {"role", "username"}};
+
+static constexpr std::array<Column, 4> STUDENT_COLUMNS = {{
+    {"ID", "id", 5}, {"Nom", "name", 25}, {"Email", "email", 30},
+    {"Date de naissance", "birthdate", 15}}};
+
+static constexpr std::array<Column, 4> COURSE_COLUMNS = {{
+    {"ID", "id", 5}, {"Cours", "name", 25}, {"Description", "description", 30},
+    {"Crédits", "credits", 10}}};
+
+static constexpr std::array<Column, 5> GRADE_COLUMNS = {{
+    {"ID", "id", 5}, {"Étudiant", "student", 25}, {"Cours", "course", 25},
+    {"Note", "grade", 8}, {"Date", "date_recorded", 15}}};
+
+static constexpr std::array<Column, 3> USER_COLUMNS = {{
+    {"ID", "id", 5}, {"Login", "username", 20}, {"Rôle", "role", 12}}};
+
+static constexpr std::array<Column, 4> PERIOD_COLUMNS = {{
+    {"Cours", "course", 25}, {"Notes", "nb", 10}, {"Moyenne", "avg", 10}, {"Dernière", "last", 12}}};
+
+static constexpr std::array<Column, 3> MENTION_COLUMNS = {{
+    {"Mention", "mention", 15}, {"Étudiants", "nb", 12}, {"Moyenne", "avg", 10}}};
+
+static constexpr std::array<Column, 5> COURSE_AVERAGE_COLUMNS = {{
+    {"Cours", "course", 25}, {"Notes", "nb", 10}, {"Moyenne", "avg", 10}, {"Min", "min", 8},
+    {"Max", "max", 8}}};
+
+static constexpr std::array<Column, 7> GRADE_HISTORY_COLUMNS = {{
+    {"Date", "changed", 20}, {"Note", "grade_id", 8}, {"Étudiant", "student", 25},
+    {"Cours", "course", 25}, {"Action", "op", 11}, {"Avant", "old_grade", 7},
+    {"Après", "new_grade", 7}}};
+
+static void printStudents(const ResultSet& rows) { printTable(STUDENT_COLUMNS, rows); }
+static void printGrades(const ResultSet& rows)   { printTable(GRADE_COLUMNS, rows); }
+static void printUsers(const ResultSet& rows)    { printTable(USER_COLUMNS, rows); }
+static void printGradeHistory(const ResultSet& rows) { printTable(GRADE_HISTORY_COLUMNS, rows); }
+
 void Admin::listStudents() {
-    auto rows = db.query("SELECT s.id, s.name, s.email, s.birthdate "
-                         "FROM students s ORDER BY s.name");
-    if (rows.empty()) { std::cout << "Aucun étudiant trouvé.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(25) << "Nom"
-              << std::setw(30) << "Email"
-              << std::setw(15) << "Date de naissance" << "\n";
-    std::cout << std::string(75, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(25) << row["name"]
-                  << std::setw(30) << row["email"]
-                  << std::setw(15) << row["birthdate"] << "\n";
-    }
+    if (!KeysetPager(db, STUDENTS_PAGE).browse(printStudents))
+        std::cout << "Aucun étudiant trouvé.\n";
 }
 
 void Admin::addStudent() {
@@ -102,40 +221,30 @@ void Admin::addStudent() {
     std::cout << "Email       : "; std::getline(std::cin, email);
     std::cout << "Date de naissance (YYYY-MM-DD) : "; std::getline(std::cin, birthdate);
 
-    std::string sql = "INSERT INTO students (name, email, birthdate) VALUES ('"
-        + db.escape(name) + "', '"
-        + db.escape(email) + "', '"
-        + db.escape(birthdate) + "')";
-
-    if (db.execute(sql))
-        std::cout << "✓ Étudiant ajouté (ID=" << db.getLastInsertId() << ")\n";
+    long long id = StudentRepository(db).add(name, email, birthdate);
+    if (id >= 0)
+        std::cout << "✓ Étudiant ajouté (ID=" << id << ")\n";
     else
         std::cout << "✗ Erreur lors de l'ajout.\n";
 }
 
 void Admin::updateStudent() {
-    listStudents();
-    int id;
-    std::cout << "ID étudiant à modifier : "; std::cin >> id; std::cin.ignore();
+    int id = RecordSelector(db).selectStudent();
+    if (id < 0) { std::cout << "Opération annulée.\n"; return; }
 
     std::string name, email;
     std::cout << "Nouveau nom  : "; std::getline(std::cin, name);
     std::cout << "Nouvel email : "; std::getline(std::cin, email);
 
-    std::string sql = "UPDATE students SET name='" + db.escape(name)
-        + "', email='" + db.escape(email)
-        + "' WHERE id=" + std::to_string(id);
-
-    if (db.execute(sql))
+    if (StudentRepository(db).update(id, name, email))
         std::cout << "✓ Étudiant mis à jour.\n";
     else
         std::cout << "✗ Erreur lors de la mise à jour.\n";
 }
 
 void Admin::deleteStudent() {
-    listStudents();
-    int id;
-    std::cout << "ID étudiant à supprimer : "; std::cin >> id; std::cin.ignore();
+    int id = RecordSelector(db).selectStudent();
+    if (id < 0) { std::cout << "Opération annulée.\n"; return; }
 
     std::string sql = "DELETE FROM students WHERE id=" + std::to_string(id);
     if (db.execute(sql))
@@ -149,21 +258,7 @@ void Admin::deleteStudent() {
 void Admin::listCourses() {
     auto rows = db.query("SELECT id, name, description, credits FROM courses ORDER BY name");
     if (rows.empty()) { std::cout << "Aucun cours trouvé.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(25) << "Cours"
-              << std::setw(30) << "Description"
-              << std::setw(10) << "Crédits" << "\n";
-    std::cout << std::string(70, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(25) << row["name"]
-                  << std::setw(30) << row["description"]
-                  << std::setw(10) << row["credits"] << "\n";
-    }
+    printTable(COURSE_COLUMNS, rows);
 }
 
 void Admin::addCourse() {
@@ -172,13 +267,13 @@ void Admin::addCourse() {
     std::cout << "Description   : "; std::getline(std::cin, desc);
     std::cout << "Crédits ECTS  : "; std::getline(std::cin, credits);
 
-    std::string sql = "INSERT INTO courses (name, description, credits) VALUES ('"
-        + db.escape(name) + "', '"
-        + db.escape(desc) + "', "
-        + db.escape(credits) + ")";
+    char* end = nullptr;
+    long value = std::strtol(credits.c_str(), &end, 10);
+    if (credits.empty() || *end != '\0' || value < 0) { std::cout << "✗ Crédits invalides.\n"; return; }
 
-    if (db.execute(sql))
-        std::cout << "✓ Cours ajouté (ID=" << db.getLastInsertId() << ")\n";
+    long long id = CourseRepository(db).add(name, desc, static_cast<int>(value));
+    if (id >= 0)
+        std::cout << "✓ Cours ajouté (ID=" << id << ")\n";
     else
         std::cout << "✗ Erreur lors de l'ajout.\n";
 }
@@ -198,102 +293,125 @@ void Admin::deleteCourse() {
 // ─── NOTES ─────────────────────────────────────────────────────────────────
 
 void Admin::listGrades() {
-    auto rows = db.query(
-        "SELECT g.id, s.name AS student, c.name AS course, g.grade, g.date_recorded "
-        "FROM grades g "
-        "JOIN students s ON g.student_id = s.id "
-        "JOIN courses  c ON g.course_id  = c.id "
-        "ORDER BY s.name, c.name");
-
-    if (rows.empty()) { std::cout << "Aucune note trouvée.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(25) << "Étudiant"
-              << std::setw(25) << "Cours"
-              << std::setw(8)  << "Note"
-              << std::setw(15) << "Date" << "\n";
-    std::cout << std::string(78, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(25) << row["student"]
-                  << std::setw(25) << row["course"]
-                  << std::setw(8)  << row["grade"]
-                  << std::setw(15) << row["date_recorded"] << "\n";
-    }
+    if (!KeysetPager(db, GRADES_PAGE).browse(printGrades))
+        std::cout << "Aucune note trouvée.\n";
 }
 
 void Admin::addGrade() {
-    listStudents();
-    int sId;
-    std::cout << "ID étudiant : "; std::cin >> sId; std::cin.ignore();
+    RecordSelector selector(db, &studentNames, &courseNames);
+    int sId = selector.selectStudent();
+    if (sId < 0) { std::cout << "Opération annulée.\n"; return; }
 
-    listCourses();
-    int cId;
-    std::cout << "ID cours    : "; std::cin >> cId; std::cin.ignore();
+    int cId = selector.selectCourse();
+    if (cId < 0) { std::cout << "Opération annulée.\n"; return; }
 
     std::string grade;
     std::cout << "Note (0-20) : "; std::getline(std::cin, grade);
 
-    std::string sql = "INSERT INTO grades (student_id, course_id, grade) VALUES ("
-        + std::to_string(sId) + ", "
-        + std::to_string(cId) + ", "
-        + db.escape(grade) + ")";
+    double value;
+    if (!GradeSession::parseGrade(grade, value)) { std::cout << "✗ Note invalide (0 à 20).\n"; return; }
 
-    if (db.execute(sql))
+    if (GradeRepository(db).add(sId, cId, value)) {
+        ResultsEngine(db).refreshStudent(sId);
         std::cout << "✓ Note ajoutée.\n";
-    else
+    } else
         std::cout << "✗ Erreur lors de l'ajout.\n";
 }
 
 void Admin::updateGrade() {
-    listGrades();
-    int id;
-    std::cout << "ID note à modifier : "; std::cin >> id; std::cin.ignore();
+    int id = RecordSelector(db).selectGrade();
+    if (id < 0) { std::cout << "Opération annulée.\n"; return; }
 
     std::string grade;
     std::cout << "Nouvelle note : "; std::getline(std::cin, grade);
 
-    std::string sql = "UPDATE grades SET grade=" + db.escape(grade)
-        + " WHERE id=" + std::to_string(id);
+    double value;
+    if (!GradeSession::parseGrade(grade, value)) { std::cout << "✗ Note invalide (0 à 20).\n"; return; }
 
-    if (db.execute(sql))
+    ResultsEngine engine(db);
+    if (GradeRepository(db).setGrade(id, value)) {
+        engine.refreshStudent(engine.studentOfGrade(id));
         std::cout << "✓ Note mise à jour.\n";
-    else
+    } else
         std::cout << "✗ Erreur.\n";
 }
 
 void Admin::deleteGrade() {
-    listGrades();
-    int id;
-    std::cout << "ID note à supprimer : "; std::cin >> id; std::cin.ignore();
+    int id = RecordSelector(db).selectGrade();
+    if (id < 0) { std::cout << "Opération annulée.\n"; return; }
 
-    if (db.execute("DELETE FROM grades WHERE id=" + std::to_string(id)))
+    ResultsEngine engine(db);
+    int sId = engine.studentOfGrade(id);
+    if (db.execute("DELETE FROM grades WHERE id=" + std::to_string(id))) {
+        engine.refreshStudent(sId);
         std::cout << "✓ Note supprimée.\n";
-    else
+    } else
         std::cout << "✗ Erreur.\n";
 }
 
+// Saisies, modifications et suppressions des notes d'un étudiant, cours par cours puis dans
+// l'ordre chronologique : parcours de idx_grade_history_student
+void Admin::gradeHistory() {
+    int sId = RecordSelector(db, &studentNames).selectStudent();
+    if (sId < 0) { std::cout << "Opération annulée.\n"; return; }
+
+    KeysetQuery page = {GRADE_HISTORY_SELECT, "h.student_id = " + std::to_string(sId),
+                        {"h.course_id", "h.changed_at", "h.id"},
+                        {"course_id", "changed_at", "id"}};
+    if (!KeysetPager(db, page).browse(printGradeHistory))
+        std::cout << "Aucune modification enregistrée pour cet étudiant.\n";
+}
+
+// Modifications des N derniers jours : parcours de idx_grade_history_time
+void Admin::recentGradeChanges() {
+    std::string text;
+    std::cout << "Nombre de jours (Entrée = 7) : "; std::getline(std::cin, text);
+    char* end = nullptr;
+    long days = text.empty() ? 7 : std::strtol(text.c_str(), &end, 10);
+    if ((end && *end != '\0') || days <= 0 || days > 36500) { std::cout << "Nombre de jours invalide.\n"; return; }
+
+    KeysetQuery page = {GRADE_HISTORY_SELECT,
+                        "h.changed_at >= CAST(strftime('%s', 'now') AS INTEGER) - "
+                            + std::to_string(days * 86400LL),
+                        {"h.changed_at", "h.id"}, {"changed_at", "id"}};
+    if (!KeysetPager(db, page).browse(printGradeHistory))
+        std::cout << "Aucune modification de note sur les " << days << " dernier(s) jour(s).\n";
+}
+
+// Notes saisies entre deux dates : bilan par cours puis liste, les deux par une
+// recherche sur idx_grades_date (dates en jours entiers, voir dates.h)
+void Admin::gradesByPeriod() {
+    std::string from, to;
+    long long first, last;
+    std::cout << "Du (AAAA-MM-JJ) : "; std::getline(std::cin, from);
+    std::cout << "Au (AAAA-MM-JJ) : "; std::getline(std::cin, to);
+    if (!parseDay(from, first) || !parseDay(to, last) || last < first) {
+        std::cout << "Période invalide.\n";
+        return;
+    }
+    std::string range = "g.date_recorded BETWEEN " + std::to_string(first) + " AND " + std::to_string(last);
+
+    auto rows = db.query("SELECT c.name AS course, COUNT(*) AS nb, printf('%.2f', AVG(g.grade)) AS avg, "
+                         + daySql("MAX(g.date_recorded)") + " AS last "
+                         "FROM grades g JOIN courses c ON g.course_id = c.id "
+                         "WHERE " + range + " GROUP BY c.id ORDER BY c.name");
+    if (rows.empty()) { std::cout << "Aucune note saisie du " << from << " au " << to << ".\n"; return; }
+    printTable(PERIOD_COLUMNS, rows);
+
+    KeysetQuery page = {"SELECT g.id, g.date_recorded AS day, s.name AS student, c.name AS course, "
+                        "g.grade, " + daySql("g.date_recorded") + " AS date_recorded "
+                        "FROM grades g "
+                        "JOIN students s ON g.student_id = s.id "
+                        "JOIN courses  c ON g.course_id  = c.id",
+                        range, {"g.date_recorded", "g.id"}, {"day", "id"}};
+    KeysetPager(db, page).browse(printGrades);
+}
+
 // ─── UTILISATEURS ──────────────────────────────────────────────────────────
 
 void Admin::listUsers() {
-    auto rows = db.query("SELECT id, username, role FROM users ORDER BY role, username");
-    if (rows.empty()) { std::cout << "Aucun utilisateur.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(20) << "Login"
-              << std::setw(12) << "Rôle" << "\n";
-    std::cout << std::string(37, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(20) << row["username"]
-                  << std::setw(12) << row["role"] << "\n";
-    }
+    if (!KeysetPager(db, USERS_PAGE).browse(printUsers))
+        std::cout << "Aucun utilisateur.\n";
 }
 
 void Admin::addUser() {
@@ -302,13 +420,9 @@ void Admin::addUser() {
     std::cout << "Mot de passe : "; std::getline(std::cin, pwd);
     std::cout << "Rôle (admin/prof/student) : "; std::getline(std::cin, role);
 
-    std::string sql = "INSERT INTO users (username, password, role) VALUES ('"
-        + db.escape(uname) + "', '"
-        + db.escape(pwd) + "', '"
-        + db.escape(role) + "')";
-
-    if (db.execute(sql))
-        std::cout << "✓ Utilisateur créé (ID=" << db.getLastInsertId() << ")\n";
+    long long id = UserRepository(db).add(uname, pwd, role);
+    if (id >= 0)
+        std::cout << "✓ Utilisateur créé (ID=" << id << ")\n";
     else
         std::cout << "✗ Erreur.\n";
 }
@@ -323,3 +437,159 @@ void Admin::deleteUser() {
     else
         std::cout << "✗ Erreur.\n";
 }
+
+// ─── RÉSULTATS ─────────────────────────────────────────────────────────────
+
+void Admin::computeResults() {
+    ResultsEngine engine(db);
+    if (engine.computeAll() < 0)
+        std::cout << "✗ Erreur lors du calcul des résultats.\n";
+}
+
+void Admin::showMentionSummary() {
+    auto rows = db.query("SELECT mention, COUNT(*) AS nb, printf('%.2f', AVG(weighted_avg)) AS avg "
+                         "FROM results GROUP BY mention ORDER BY MIN(weighted_avg) DESC");
+    if (rows.empty()) { std::cout << "Aucun résultat calculé.\n"; return; }
+    printTable(MENTION_COLUMNS, rows);
+}
+
+void Admin::showStudentResult() {
+    int id;
+    std::cout << "ID étudiant : "; std::cin >> id; std::cin.ignore();
+
+    // nom, moyenne, crédits acquis, crédits restants, mention, décision, date du calcul
+    using Result = std::tuple<std::string, double, int, int, std::string, std::string, std::string>;
+    auto result = TypedQuery<Result, int>(db, "SELECT s.name, r.weighted_avg, r.credits_earned, "
+                                              "r.credits_outstanding, r.mention, r.decision, " +
+                                              timeSql("r.computed_at") + " FROM results r "
+                                              "JOIN students s ON r.student_id = s.id "
+                                              "WHERE r.student_id = ?")
+                      .bind(id)
+                      .one();
+    if (!result) { std::cout << "Aucun résultat pour cet étudiant.\n"; return; }
+
+    const auto& [name, avg, earned, outstanding, mention, decision, computed] = *result;
+    std::cout << "\n  Étudiant        : " << name << "\n";
+    if (mention == "-")
+        std::cout << "  Moyenne         : -\n";
+    else
+        std::cout << "  Moyenne         : " << std::fixed << std::setprecision(2)
+                  << avg << " / 20 (" << mention << ")\n";
+    std::cout << "  Crédits acquis  : " << earned << "\n";
+    std::cout << "  Crédits restants: " << outstanding << "\n";
+    std::cout << "  Décision        : " << decision << "\n";
+    std::cout << "  Calculé le      : " << computed << "\n";
+}
+
+void Admin::generateTranscripts() {
+    std::string directory;
+    std::cout << "Répertoire des relevés (Entrée = releves) : ";
+    std::getline(std::cin, directory);
+    if (directory.empty()) directory = "releves";
+    if (TranscriptGenerator(db).generateAll(directory) < 0)
+        std::cout << "✗ Erreur lors de la génération des relevés.\n";
+}
+
+// ─── OUTILS ────────────────────────────────────────────────────────────────
+
+void Admin::benchmarkDisplay() {
+    int target = 0;
+    std::cout << "Sortie : [1] /dev/null  [2] stdout\nChoix : ";
+    std::cin >> target; std::cin.ignore();
+    benchmarkTableRenderer(1000000, target == 2);
+}
+
+void Admin::changeGradesLayout() {
+    bool clustered = db.gradesLayout() == GradesLayout::CLUSTERED;
+    std::cout << "Disposition actuelle : " << (clustered ? "groupée par étudiant (WITHOUT ROWID)" : "rowid")
+              << "\nReconstruire la table des notes en disposition "
+              << (clustered ? "rowid" : "groupée par étudiant") << " ? (o/n) : ";
+    std::string answer;
+    std::getline(std::cin, answer);
+    if (answer != "o" && answer != "O") { std::cout << "Opération annulée.\n"; return; }
+
+    auto start = std::chrono::steady_clock::now();
+    if (!db.setGradesLayout(clustered ? GradesLayout::ROWID : GradesLayout::CLUSTERED)) {
+        std::cout << "✗ Reconstruction impossible, disposition inchangée.\n";
+        return;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "✓ Table des notes reconstruite (" << std::fixed << std::setprecision(1)
+              << elapsed.count() << " s)\n";
+}
+
+void Admin::benchmarkLayout() {
+    std::string text;
+    std::cout << "Nombre d'étudiants (Entrée = 1000) : "; std::getline(std::cin, text);
+    char* end = nullptr;
+    long lookups = text.empty() ? 1000 : std::strtol(text.c_str(), &end, 10);
+    if ((end && *end != '\0') || lookups <= 0) { std::cout << "Nombre invalide.\n"; return; }
+    benchmarkGradesLayout(db, static_cast<size_t>(lookups));
+}
+
+void Admin::shardDatabase() {
+    std::string text;
+    std::cout << "Nombre de fichiers (Entrée = 4) : "; std::getline(std::cin, text);
+    char* end = nullptr;
+    long count = text.empty() ? 4 : std::strtol(text.c_str(), &end, 10);
+    if ((end && *end != '\0') || count < 1 || count > 64) { std::cout << "Nombre invalide.\n"; return; }
+
+    std::cout << "Les fichiers " << ShardedDatabase::shardPath(db.getPath(), 0) << " à "
+              << ShardedDatabase::shardPath(db.getPath(), static_cast<size_t>(count - 1))
+              << " seront recréés. Continuer ? (o/n) : ";
+    std::getline(std::cin, text);
+    if (text != "o" && text != "O") { std::cout << "Opération annulée.\n"; return; }
+
+    ShardedDatabase shards(db.getPath(), static_cast<size_t>(count));
+    if (!shards.split(db)) { std::cout << "✗ Répartition impossible.\n"; return; }
+
+    // Lectures globales : tous les fichiers interrogés en parallèle, résultats fusionnés
+    auto start = std::chrono::steady_clock::now();
+    ResultSet averages = shards.courseAverages();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "\nMoyennes par cours sur " << shards.size() << " fichier(s) ("
+              << std::fixed << std::setprecision(2) << elapsed.count() << " s)";
+    printTable(COURSE_AVERAGE_COLUMNS, averages);
+
+    start = std::chrono::steady_clock::now();
+    ResultSet grades = shards.listGrades(10);
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "\nListe globale des notes, 10 premières (" << std::setprecision(2) << elapsed.count() << " s)";
+    printGrades(grades);
+
+    std::cout << "\nMesurer les écritures routées (1 fichier contre " << count << ") ? (o/n) : ";
+    std::getline(std::cin, text);
+    if (text == "o" || text == "O")
+        benchmarkShardedWrites(db.getPath() + ".bench", static_cast<size_t>(count), 2000, 50);
+}
+
+void Admin::queryCache() {
+    std::string answer;
+    QueryCache* cache = db.getCache();
+    if (!cache) {
+        std::cout << "Cache des requêtes désactivé. L'activer (budget "
+                  << QueryCache::DEFAULT_BUDGET / (1 << 20) << " Mo) ? (o/n) : ";
+        std::getline(std::cin, answer);
+        if (answer != "o" && answer != "O") return;
+        db.enableCache(QueryCache::DEFAULT_BUDGET);
+        std::cout << (db.getCache() ? "✓ Cache activé.\n" : "✗ Activation impossible.\n");
+        return;
+    }
+
+    QueryCacheStats s = cache->statistics();
+    long long lookups = s.hits + s.misses;
+    std::cout << "\n  Requêtes servies   : " << s.hits << " depuis le cache, " << s.misses << " exécutées";
+    if (lookups > 0)
+        std::cout << " (" << std::fixed << std::setprecision(1) << 100.0 * s.hits / lookups << " % de succès)";
+    std::cout << "\n  Non cachables      : " << s.bypassed << "\n";
+    std::cout << "  Invalidations      : " << s.invalidations << "\n";
+    std::cout << "  Évictions (LRU)    : " << s.evictions << "\n";
+    std::cout << "  Entrées            : " << s.entries << " (" << std::fixed << std::setprecision(2)
+              << s.bytes / 1048576.0 << " / " << s.budget / 1048576.0 << " Mo)\n";
+    std::cout << "Désactiver le cache ? (o/n) : ";
+    std::getline(std::cin, answer);
+    if (answer == "o" || answer == "O") {
+        db.disableCache();
+        std::cout << "✓ Cache désactivé.\n";
+    }
+}
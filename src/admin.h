@@ -3,10 +3,13 @@
 
 #include "user.h"
 #include "database.h"
+#include "prefixindex.h"
 
 class Admin : public User {
 private:
-    Database& db;
+    Database&   db;
+    PrefixIndex studentNames;   // complétion des noms, construite à la connexion
+    PrefixIndex courseNames;
 
 public:
     Admin(int id, const std::string& username, const std::string& password, Database& db);
@@ -29,11 +32,27 @@ public:
     void addGrade();
     void updateGrade();
     void deleteGrade();
+    void gradeHistory();
+    void recentGradeChanges();
+    void gradesByPeriod();
 
     // Gestion des utilisateurs
     void listUsers();
     void addUser();
     void deleteUser();
+
+    // Résultats de la promotion
+    void computeResults();
+    void showMentionSummary();
+    void showStudentResult();
+    void generateTranscripts();
+
+    // Outils
+    void benchmarkDisplay();
+    void changeGradesLayout();
+    void benchmarkLayout();
+    void shardDatabase();
+    void queryCache();
 };
 
 #endif // ADMIN_H
@@ -0,0 +1,123 @@
+#include "changefeed.h"
+#include <algorithm>
+
+ChangeFeed::ChangeFeed(sqlite3* handle) : handle(handle) {
+    sqlite3_update_hook(handle, &ChangeFeed::onUpdate, this);
+    sqlite3_commit_hook(handle, &ChangeFeed::onCommit, this);
+    sqlite3_rollback_hook(handle, &ChangeFeed::onRollback, this);
+}
+
+ChangeFeed::~ChangeFeed() {
+    sqlite3_update_hook(handle, nullptr, nullptr);
+    sqlite3_commit_hook(handle, nullptr, nullptr);
+    sqlite3_rollback_hook(handle, nullptr, nullptr);
+}
+
+// ─── Hooks SQLite (appelés pendant sqlite3_step, sur le thread de la connexion) ──
+
+void ChangeFeed::onUpdate(void* self, int op, const char*, const char* table, sqlite3_int64 rowid) {
+    auto* feed = static_cast<ChangeFeed*>(self);
+    if (feed->subscribers.empty() || feed->pendingLost) return;
+    if (feed->pending.size() >= MAX_PENDING) {
+        // Trop gros pour être suivi ligne à ligne (import massif) : les abonnés rechargeront
+        feed->pending.clear();
+        feed->pendingLost = true;
+        return;
+    }
+    char code = op == SQLITE_INSERT ? 'I' : op == SQLITE_UPDATE ? 'U' : 'D';
+    feed->pending.push_back({table, code, rowid});
+}
+
+int ChangeFeed::onCommit(void* self) {
+    // Le COMMIT peut encore échouer (SQLITE_BUSY) : publication après coup seulement
+    auto* feed = static_cast<ChangeFeed*>(self);
+    feed->committed.insert(feed->committed.end(),
+                           std::make_move_iterator(feed->pending.begin()),
+                           std::make_move_iterator(feed->pending.end()));
+    feed->committedLost = feed->committedLost || feed->pendingLost;
+    feed->pending.clear();
+    feed->pendingLost = false;
+    return 0;
+}
+
+void ChangeFeed::onRollback(void* self) {
+    auto* feed = static_cast<ChangeFeed*>(self);
+    feed->pending.clear();
+    feed->committed.clear();
+    feed->pendingLost = feed->committedLost = false;
+}
+
+// ─── Publication ───────────────────────────────────────────────────────────
+
+size_t ChangeFeed::beginStatement() const { return pending.size(); }
+
+void ChangeFeed::endStatement(size_t mark, bool failed) {
+    // Requête en échec : SQLite a annulé ses effets, les changements vus sont caducs
+    if (failed && mark <= pending.size()) pending.resize(mark);
+
+    // Hors transaction : tout ce qui a été validé l'est définitivement
+    if (sqlite3_get_autocommit(handle)) {
+        pending.clear();
+        pendingLost = false;
+        publish();
+    }
+}
+
+void ChangeFeed::resolveLogged() {
+    long long first = -1, last = -1;
+    for (const auto& change : committed)
+        if (change.op == 'I' && change.table == "change_log") {
+            if (first < 0 || change.rowid < first) first = change.rowid;
+            last = std::max(last, change.rowid);
+        }
+    if (first < 0) return;
+
+    // Appelé après sqlite3_step (hors hook) : la connexion peut exécuter une requête.
+    // Les numéros d'une transaction sont contigus (un seul writer à la fois).
+    sqlite3_stmt* stmt = nullptr;
+    const char* sql =
+        "SELECT c.table_name, c.op, c.row_id FROM change_log c "
+        "JOIN pragma_table_list t ON t.schema = 'main' AND t.name = c.table_name "
+        "WHERE c.seq BETWEEN ?1 AND ?2 AND t.wr = 1 ORDER BY c.seq";
+    if (sqlite3_prepare_v2(handle, sql, -1, &stmt, nullptr) != SQLITE_OK) {
+        committedLost = true;   // les abonnés rechargeront leur état
+        return;
+    }
+    sqlite3_bind_int64(stmt, 1, first);
+    sqlite3_bind_int64(stmt, 2, last);
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
+        auto* table = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 0));
+        auto* op    = reinterpret_cast<const char*>(sqlite3_column_text(stmt, 1));
+        committed.push_back({table ? table : "", op ? op[0] : 'U', sqlite3_column_int64(stmt, 2)});
+    }
+    if (rc != SQLITE_DONE) committedLost = true;
+    sqlite3_finalize(stmt);
+}
+
+void ChangeFeed::publish() {
+    if (committed.empty() && !committedLost) return;
+    if (!committedLost) resolveLogged();
+    for (auto& sub : subscribers) {
+        if (committedLost) sub->lost = true;
+        for (auto& change : committed) {
+            RowChange copy = change;
+            if (!sub->ring.tryPush(copy)) { sub->lost = true; break; }
+        }
+    }
+    committed.clear();
+    committedLost = false;
+}
+
+// ─── Abonnements ───────────────────────────────────────────────────────────
+
+std::shared_ptr<ChangeSubscription> ChangeFeed::subscribe(size_t capacity) {
+    auto sub = std::make_shared<ChangeSubscription>(capacity);
+    subscribers.push_back(sub);
+    return sub;
+}
+
+void ChangeFeed::unsubscribe(const std::shared_ptr<ChangeSubscription>& subscription) {
+    subscribers.erase(std::remove(subscribers.begin(), subscribers.end(), subscription),
+                      subscribers.end());
+}
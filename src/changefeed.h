@@ -0,0 +1,82 @@
+#ifndef CHANGEFEED_H
+#define CHANGEFEED_H
+
+#include "sqlite3.h"
+#include "boundedqueue.h"
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Une ligne modifiée par une transaction validée
+struct RowChange {
+    std::string table;
+    char        op    = 'I';   // 'I' insertion, 'U' modification, 'D' suppression
+    long long   rowid = 0;
+};
+
+// File d'un abonné : remplie par le thread qui valide les transactions, vidée par
+// l'abonné avec poll(), sans verrou. Si l'abonné ne suit pas (file pleine), les
+// changements suivants sont perdus et overflowed() le signale : il doit alors
+// recharger son état depuis la base au lieu de l'appliquer par incréments.
+class ChangeSubscription {
+private:
+    BoundedQueue<RowChange> ring;
+    std::atomic<bool>       lost{false};
+
+    friend class ChangeFeed;
+
+public:
+    explicit ChangeSubscription(size_t capacity) : ring(capacity) {}
+
+    bool poll(RowChange& change) { return ring.tryPop(change); }
+
+    // Vrai (une seule fois) si des changements ont été perdus depuis le dernier appel
+    bool overflowed() { return lost.exchange(false); }
+};
+
+// Capture des changements d'une connexion (sqlite3_update_hook / commit_hook /
+// rollback_hook). Les changements d'une transaction sont retenus jusqu'au COMMIT
+// effectif puis publiés aux abonnés ; ceux d'une transaction annulée, ou d'une
+// requête en échec (annulée au niveau requête), ne sont jamais publiés.
+// Tables WITHOUT ROWID (grades en disposition groupée) : update_hook ne les signale
+// pas, mais leurs triggers écrivent change_log, qui l'est. Ces lignes de change_log
+// sont relues après le COMMIT et publiées comme changements de la table journalisée.
+// Limite de SQLite : les suppressions faites par REPLACE ne sont pas signalées.
+class ChangeFeed {
+public:
+    static constexpr size_t MAX_PENDING      = 1 << 16;   // au-delà : abonnés marqués « perdus »
+    static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+private:
+    sqlite3*               handle;
+    std::vector<RowChange> pending;      // transaction en cours
+    std::vector<RowChange> committed;    // validés par commit_hook, publiés après le COMMIT
+    bool                   pendingLost   = false;
+    bool                   committedLost = false;
+    std::vector<std::shared_ptr<ChangeSubscription>> subscribers;
+
+    static void onUpdate(void* self, int op, const char* dbName, const char* table, sqlite3_int64 rowid);
+    static int  onCommit(void* self);
+    static void onRollback(void* self);
+
+    void publish();
+    void resolveLogged();   // changements des tables sans rowid, d'après change_log
+
+public:
+    explicit ChangeFeed(sqlite3* handle);
+    ~ChangeFeed();
+
+    ChangeFeed(const ChangeFeed&) = delete;
+    ChangeFeed& operator=(const ChangeFeed&) = delete;
+
+    // Abonnement / désabonnement depuis le thread propriétaire de la connexion
+    std::shared_ptr<ChangeSubscription> subscribe(size_t capacity = DEFAULT_CAPACITY);
+    void unsubscribe(const std::shared_ptr<ChangeSubscription>& subscription);
+
+    // Encadrement de chaque requête exécutée sur la connexion
+    size_t beginStatement() const;
+    void   endStatement(size_t mark, bool failed);
+};
+
+#endif // CHANGEFEED_H
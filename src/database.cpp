@@ -1,11 +1,15 @@
 #include "database.h"
+#include "querycache.h"
+#include <chrono>
+#include <optional>
 #include <sstream>
 
-Database::Database(const std::string& dbPath) : db(nullptr), dbPath(dbPath) {}
+Database::Database(const std::string& dbPath) : db(nullptr), dbPath(dbPath), testData(true) {}
 
 Database::~Database() { disconnect(); }
 
-bool Database::connect() {
+bool Database::connect(bool withTestData) {
+    testData = withTestData;
     int rc = sqlite3_open(dbPath.c_str(), &db);
     if (rc != SQLITE_OK) {
         std::cerr << "[DB ERROR] " << sqlite3_errmsg(db) << std::endl;
@@ -14,17 +18,59 @@ bool Database::connect() {
     }
     // Activer les clés étrangères
     execute("PRAGMA foreign_keys = ON;");
+    // WAL : les lectures longues (exports) ne bloquent pas les écritures
+    execute("PRAGMA journal_mode = WAL;");
+    // Journaux de requête (triggers, INSERT OR IGNORE) en mémoire plutôt qu'en fichier temporaire
+    execute("PRAGMA temp_store = MEMORY;");
+    feed = std::make_unique<ChangeFeed>(db);
     std::cout << "[DB] Connecté à : " << dbPath << std::endl;
     initSchema();
     return true;
 }
 
+bool Database::connectReadOnly() {
+    int rc = sqlite3_open_v2(dbPath.c_str(), &db,
+                             SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr);
+    if (rc != SQLITE_OK) {
+        std::cerr << "[DB ERROR] " << sqlite3_errmsg(db) << std::endl;
+        sqlite3_close(db);
+        db = nullptr;
+        return false;
+    }
+    sqlite3_busy_timeout(db, 5000);
+    return true;
+}
+
 void Database::disconnect() {
+    cache.reset();   // désabonné du flux, requête préparée finalisée
+    feed.reset();
     if (db) { sqlite3_close(db); db = nullptr; }
 }
 
 bool Database::isConnected() const { return db != nullptr; }
 
+const std::string& Database::getPath() const { return dbPath; }
+
+sqlite3* Database::getHandle() const { return db; }
+
+ChangeFeed* Database::getFeed() const { return feed.get(); }
+
+void Database::enableCache(size_t budgetBytes) {
+    if (db && feed) cache = std::make_unique<QueryCache>(*this, budgetBytes);
+}
+
+void Database::disableCache() { cache.reset(); }
+
+QueryCache* Database::getCache() const { return cache.get(); }
+
+std::shared_ptr<ChangeSubscription> Database::subscribe(size_t capacity) {
+    return feed ? feed->subscribe(capacity) : nullptr;
+}
+
+void Database::unsubscribe(const std::shared_ptr<ChangeSubscription>& subscription) {
+    if (feed) feed->unsubscribe(subscription);
+}
+
 // Callback interne pour récupérer les résultats
 static int queryCallback(void* data, int argc, char** argv, char** colNames) {
     auto* results = static_cast<ResultSet*>(data);
@@ -37,8 +83,11 @@ static int queryCallback(void* data, int argc, char** argv, char** colNames) {
 
 ResultSet Database::query(const std::string& sql) {
     ResultSet results;
+    if (cache && cache->fetch(sql, {}, results)) return results;
     char* errMsg = nullptr;
-    sqlite3_exec(db, sql.c_str(), queryCallback, &results, &errMsg);
+    size_t mark = feed ? feed->beginStatement() : 0;
+    int rc = sqlite3_exec(db, sql.c_str(), queryCallback, &results, &errMsg);
+    if (feed) feed->endStatement(mark, rc != SQLITE_OK);
     if (errMsg) {
         std::cerr << "[DB ERROR] " << errMsg << std::endl;
         sqlite3_free(errMsg);
@@ -46,9 +95,21 @@ ResultSet Database::query(const std::string& sql) {
     return results;
 }
 
+ResultSet Database::query(const std::string& sql, const std::vector<std::string>& params) {
+    ResultSet results;
+    if (cache && cache->fetch(sql, params, results)) return results;
+    Statement stmt(*this, sql);
+    for (size_t i = 0; i < params.size(); ++i)
+        stmt.bind(static_cast<int>(i + 1), params[i]);
+    while (stmt.step()) results.push_back(stmt.getRow());
+    return results;
+}
+
 bool Database::execute(const std::string& sql) {
     char* errMsg = nullptr;
+    size_t mark = feed ? feed->beginStatement() : 0;
     int rc = sqlite3_exec(db, sql.c_str(), nullptr, nullptr, &errMsg);
+    if (feed) feed->endStatement(mark, rc != SQLITE_OK);
     if (rc != SQLITE_OK) {
         std::cerr << "[DB ERROR] " << errMsg << std::endl;
         sqlite3_free(errMsg);
@@ -71,28 +132,248 @@ std::string Database::escape(const std::string& value) {
     return result;
 }
 
-void Database::initSchema() {
-    // Création des tables
-    execute(R"(
-        CREATE TABLE IF NOT EXISTS users (
+bool Database::begin()    { return execute("BEGIN;"); }
+bool Database::commit()   { return execute("COMMIT;"); }
+bool Database::rollback() { return execute("ROLLBACK;"); }
+
+// ─── Schéma ────────────────────────────────────────────────────────────────
+
+// Colonnes des tables que migrate() peut reconstruire : une seule définition pour la
+// création et la reconstruction. Dates en entiers, voir dates.h.
+static const char* USERS_COLUMNS = R"(
             id         INTEGER PRIMARY KEY AUTOINCREMENT,
             username   TEXT NOT NULL UNIQUE,
             password   TEXT NOT NULL,
             role       TEXT NOT NULL CHECK(role IN ('admin','prof','student')),
             email      TEXT,
-            created_at TEXT DEFAULT (datetime('now'))
-        );
-    )");
+            created_at INTEGER DEFAULT (CAST(strftime('%s','now') AS INTEGER))
+)";
 
-    execute(R"(
-        CREATE TABLE IF NOT EXISTS students (
+static const char* STUDENTS_COLUMNS = R"(
             id         INTEGER PRIMARY KEY AUTOINCREMENT,
             name       TEXT NOT NULL,
             email      TEXT UNIQUE,
             birthdate  TEXT,
-            created_at TEXT DEFAULT (datetime('now'))
-        );
-    )");
+            created_at INTEGER DEFAULT (CAST(strftime('%s','now') AS INTEGER))
+)";
+
+static const char* GRADES_COLUMNS = R"(
+            id            INTEGER PRIMARY KEY AUTOINCREMENT,
+            student_id    INTEGER NOT NULL,
+            course_id     INTEGER NOT NULL,
+            grade         REAL    NOT NULL CHECK(grade >= 0 AND grade <= 20),
+            date_recorded INTEGER DEFAULT (CAST(strftime('%s','now') AS INTEGER) / 86400),
+            FOREIGN KEY (student_id) REFERENCES students(id) ON DELETE CASCADE,
+            FOREIGN KEY (course_id)  REFERENCES courses(id)  ON DELETE CASCADE
+)";
+
+// Résultats calculés par ResultsEngine (moyenne pondérée, mention, progression ECTS)
+static const char* RESULTS_COLUMNS = R"(
+            student_id          INTEGER PRIMARY KEY,
+            weighted_avg        REAL    NOT NULL,
+            credits             INTEGER NOT NULL,
+            credits_earned      INTEGER NOT NULL,
+            credits_outstanding INTEGER NOT NULL,
+            mention             TEXT    NOT NULL,
+            decision            TEXT    NOT NULL CHECK(decision IN ('ADMIS','REDOUBLE')),
+            computed_at         INTEGER DEFAULT (CAST(strftime('%s','now') AS INTEGER)),
+            FOREIGN KEY (student_id) REFERENCES students(id) ON DELETE CASCADE
+)";
+
+// Points de reprise des imports (BulkImporter), un par contenu de fichier importé
+static const char* IMPORT_CHECKPOINTS_COLUMNS = R"(
+            file_hash   TEXT    NOT NULL,
+            sections    TEXT    NOT NULL,
+            filename    TEXT,
+            pass        INTEGER NOT NULL,
+            byte_offset INTEGER NOT NULL,
+            rows_done   INTEGER NOT NULL DEFAULT 0,
+            updated_at  INTEGER DEFAULT (CAST(strftime('%s','now') AS INTEGER)),
+            PRIMARY KEY (file_hash, sections)
+)";
+
+// Historique des notes, en ajout seul : une ligne par création (old_grade NULL),
+// modification ou suppression. Pas de clé étrangère : l'historique survit à la
+// suppression de l'étudiant ou du cours.
+static const char* GRADE_HISTORY_COLUMNS = R"(
+            id         INTEGER PRIMARY KEY,
+            grade_id   INTEGER NOT NULL,
+            student_id INTEGER NOT NULL,
+            course_id  INTEGER NOT NULL,
+            op         TEXT    NOT NULL CHECK(op IN ('I','U','D')),
+            old_grade  REAL,
+            new_grade  REAL,
+            changed_at INTEGER NOT NULL DEFAULT (CAST(strftime('%s','now') AS INTEGER))
+)";
+
+// Disposition groupée de grades (WITHOUT ROWID) : les notes d'un étudiant sont rangées
+// côte à côte dans l'arbre de la table, dans l'ordre de la clé primaire
+static const char* GRADES_CLUSTERED_COLUMNS = R"(
+            id            INTEGER NOT NULL,
+            student_id    INTEGER NOT NULL,
+            course_id     INTEGER NOT NULL,
+            grade         REAL    NOT NULL CHECK(grade >= 0 AND grade <= 20),
+            date_recorded INTEGER DEFAULT (CAST(strftime('%s','now') AS INTEGER) / 86400),
+            PRIMARY KEY (student_id, course_id, id),
+            FOREIGN KEY (student_id) REFERENCES students(id) ON DELETE CASCADE,
+            FOREIGN KEY (course_id)  REFERENCES courses(id)  ON DELETE CASCADE
+)";
+
+// Sans rowid, pas d'AUTOINCREMENT : une note insérée sans ID est réécrite avec le
+// suivant (compteur de sqlite_sequence, comme AUTOINCREMENT), puis l'insertion d'origine
+// est abandonnée par RAISE(IGNORE). Les triggers AFTER INSERT ne voient que la réécriture ;
+// changes() de la requête d'origine vaut 0.
+static const char* GRADES_ID_TRIGGER = R"(
+        CREATE TRIGGER IF NOT EXISTS trg_grades_id BEFORE INSERT ON grades WHEN NEW.id IS NULL
+        BEGIN
+            UPDATE sqlite_sequence SET seq = max(seq, (SELECT ifnull(max(id), 0) FROM grades)) + 1
+            WHERE name = 'grades';
+            INSERT INTO grades (id, student_id, course_id, grade, date_recorded)
+            VALUES ((SELECT seq FROM sqlite_sequence WHERE name = 'grades'),
+                    NEW.student_id, NEW.course_id, NEW.grade, NEW.date_recorded);
+            SELECT RAISE(IGNORE);
+        END;
+)";
+
+static std::string createTable(const std::string& name, const char* columns, const char* options = "") {
+    return "CREATE TABLE IF NOT EXISTS " + name + " (" + columns + ")" + options + ";";
+}
+
+std::string Database::gradesTableSql(const std::string& name, GradesLayout layout) {
+    return layout == GradesLayout::CLUSTERED
+        ? createTable(name, GRADES_CLUSTERED_COLUMNS, " WITHOUT ROWID")
+        : createTable(name, GRADES_COLUMNS);
+}
+
+// Reconstruit une table (ALTER TABLE ne change pas le type d'une colonne), selon la
+// procédure de la documentation SQLite : nouvelle table, copie, suppression, renommage.
+// Ses index et triggers disparaissent avec l'ancienne ; initSchema les recrée ensuite.
+bool Database::rebuildTable(const std::string& table, const std::string& create, const std::string& select) {
+    // Compteur AUTOINCREMENT (ou celui de trg_grades_id) : un ID déjà attribué puis
+    // supprimé ne doit pas revenir, quelle que soit la disposition d'arrivée. Les tables
+    // sans compteur (results, import_checkpoints...) n'en reçoivent pas.
+    std::optional<long long> sequence;
+    {
+        Statement seq(*this, "SELECT seq FROM sqlite_sequence WHERE name = ?");
+        seq.bind(1, table);
+        if (seq.step()) sequence = seq.getInt(0);
+    }
+    std::string rebuilt = table + "_rebuild";
+    bool ok = execute(create)
+        && execute("INSERT INTO " + rebuilt + " " + select + ";")
+        && execute("DROP TABLE " + table + ";")
+        && execute("ALTER TABLE " + rebuilt + " RENAME TO " + table + ";");
+    if (!ok || !sequence) return ok;
+    return execute("DELETE FROM sqlite_sequence WHERE name = '" + table + "';")
+        && execute("INSERT INTO sqlite_sequence (name, seq) SELECT '" + table + "', max(" +
+                   std::to_string(*sequence) + ", ifnull(max(id), 0)) FROM " + table + ";");
+}
+
+// Reconstructions tout ou rien, clés étrangères suspendues (ce PRAGMA n'agit que hors
+// transaction) : la suppression de l'ancienne table ne doit rien cascader
+bool Database::rebuildAll(const std::function<bool()>& steps) {
+    execute("PRAGMA foreign_keys = OFF;");
+    bool ok = begin() && steps() && commit();
+    if (!ok) rollback();
+    execute("PRAGMA foreign_keys = ON;");
+    return ok;
+}
+
+// Appelée par initSchema une fois les tables créées, avant leurs index et triggers
+bool Database::migrate() {
+    int version = 0;
+    {
+        Statement stmt(*this, "PRAGMA user_version");
+        if (stmt.step()) version = static_cast<int>(stmt.getInt(0));
+    }
+    if (version >= SCHEMA_VERSION) return true;
+
+    // Version 1 : dates TEXT → entiers. Une base neuve a déjà les bons types.
+    auto declared = [this](const char* table, const char* column) {
+        Statement stmt(*this, std::string("SELECT type FROM pragma_table_info('") + table +
+                              "') WHERE name = '" + column + "'");
+        return stmt.step() ? stmt.getText(0) : std::string();
+    };
+    struct Rebuild { const char* table; const char* column; const char* columns; const char* select; };
+    const Rebuild rebuilds[] = {
+        {"users", "created_at", USERS_COLUMNS,
+         "SELECT id, username, password, role, email, "
+         "CAST(strftime('%s', created_at) AS INTEGER) FROM users"},
+        {"students", "created_at", STUDENTS_COLUMNS,
+         "SELECT id, name, email, birthdate, CAST(strftime('%s', created_at) AS INTEGER) FROM students"},
+        {"grades", "date_recorded", GRADES_COLUMNS,
+         "SELECT id, student_id, course_id, grade, "
+         "CAST(strftime('%s', date_recorded) AS INTEGER) / 86400 FROM grades"},
+        // Version 2 : horodatages restés en TEXT
+        {"results", "computed_at", RESULTS_COLUMNS,
+         "SELECT student_id, weighted_avg, credits, credits_earned, credits_outstanding, mention, "
+         "decision, CAST(strftime('%s', computed_at) AS INTEGER) FROM results"},
+        {"import_checkpoints", "updated_at", IMPORT_CHECKPOINTS_COLUMNS,
+         "SELECT file_hash, sections, filename, pass, byte_offset, rows_done, "
+         "CAST(strftime('%s', updated_at) AS INTEGER) FROM import_checkpoints"}};
+    std::vector<const Rebuild*> pending;
+    for (const Rebuild& r : rebuilds)
+        if (declared(r.table, r.column) == "TEXT") pending.push_back(&r);
+
+    // Version 2 : grade_history accepte les créations (op 'I', sans ancienne note).
+    // Une CHECK ne se modifie pas : reconstruction si old_grade est encore NOT NULL.
+    bool historyRebuild = false;
+    {
+        Statement stmt(*this, "SELECT \"notnull\" FROM pragma_table_info('grade_history') "
+                              "WHERE name = 'old_grade'");
+        historyRebuild = stmt.step() && stmt.getInt(0) != 0;
+    }
+
+    if (!pending.empty() || historyRebuild) {
+        auto start = std::chrono::steady_clock::now();
+        bool ok = rebuildAll([&]() {
+            for (const Rebuild* r : pending)
+                if (!rebuildTable(r->table, createTable(std::string(r->table) + "_rebuild", r->columns),
+                                  r->select))
+                    return false;
+            // Les triggers de grades qui écrivent dans grade_history empêcheraient le
+            // renommage ; initSchema les recrée
+            return !historyRebuild
+                || (execute("DROP TRIGGER IF EXISTS trg_grades_history_upd;")
+                    && execute("DROP TRIGGER IF EXISTS trg_grades_history_del;")
+                    && rebuildTable("grade_history",
+                                    createTable("grade_history_rebuild", GRADE_HISTORY_COLUMNS),
+                                    "SELECT * FROM grade_history ORDER BY id"));
+        });
+        if (!ok) {
+            std::cerr << "[DB ERROR] Migration du schéma vers la version " << SCHEMA_VERSION
+                      << " échouée, base inchangée.\n";
+            return false;
+        }
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << "✓ Schéma mis à niveau (version " << SCHEMA_VERSION << ", "
+                  << static_cast<long long>(elapsed.count()) << " ms)\n";
+    }
+    return execute("PRAGMA user_version = " + std::to_string(SCHEMA_VERSION) + ";");
+}
+
+GradesLayout Database::gradesLayout() const {
+    // Seule une table WITHOUT ROWID a un index de clé primaire (origine 'pk')
+    Statement stmt(*this, "SELECT 1 FROM pragma_index_list('grades') WHERE origin = 'pk'");
+    return stmt.step() ? GradesLayout::CLUSTERED : GradesLayout::ROWID;
+}
+
+bool Database::setGradesLayout(GradesLayout layout) {
+    if (gradesLayout() == layout) return true;
+    bool clustered = layout == GradesLayout::CLUSTERED;
+    // Copie dans l'ordre de la table d'arrivée : ajouts en fin d'arbre, sans tri
+    std::string select = std::string("SELECT id, student_id, course_id, grade, date_recorded FROM grades ") +
+                         (clustered ? "ORDER BY student_id, course_id, id" : "ORDER BY id");
+    if (!rebuildAll([&]() { return rebuildTable("grades", gradesTableSql("grades_rebuild", layout), select); }))
+        return false;
+    initSchema();   // index et triggers de grades, selon la nouvelle disposition
+    return true;
+}
+
+void Database::initSchema() {
+    // Création des tables
+    execute(createTable("users", USERS_COLUMNS));
+    execute(createTable("students", STUDENTS_COLUMNS));
 
     execute(R"(
         CREATE TABLE IF NOT EXISTS courses (
@@ -103,20 +384,162 @@ void Database::initSchema() {
         );
     )");
 
+    execute(createTable("grades", GRADES_COLUMNS));
+
+    execute(createTable("results", RESULTS_COLUMNS));
+
+    // Bases créées par une version précédente : mise à niveau avant les index et triggers
+    migrate();
+
+    // Journal des modifications : une ligne par INSERT / UPDATE / DELETE sur les tables
+    // exportées, tenue par triggers. Son dernier numéro (la génération) identifie l'état
+    // lu par un export et sert de point de départ aux exports différentiels.
     execute(R"(
-        CREATE TABLE IF NOT EXISTS grades (
-            id            INTEGER PRIMARY KEY AUTOINCREMENT,
-            student_id    INTEGER NOT NULL,
-            course_id     INTEGER NOT NULL,
-            grade         REAL    NOT NULL CHECK(grade >= 0 AND grade <= 20),
-            date_recorded TEXT    DEFAULT (date('now')),
-            FOREIGN KEY (student_id) REFERENCES students(id) ON DELETE CASCADE,
-            FOREIGN KEY (course_id)  REFERENCES courses(id)  ON DELETE CASCADE
+        CREATE TABLE IF NOT EXISTS change_log (
+            seq        INTEGER PRIMARY KEY AUTOINCREMENT,
+            table_name TEXT    NOT NULL,
+            row_id     INTEGER NOT NULL,
+            op         TEXT    NOT NULL CHECK(op IN ('I','U','D')),
+            changed_at INTEGER NOT NULL DEFAULT (CAST(strftime('%s','now') AS INTEGER))
+        );
+    )");
+    // Exports réussis (génération lue) et purges du journal : un export différentiel
+    // depuis une génération antérieure à la dernière purge serait incomplet
+    execute(R"(
+        CREATE TABLE IF NOT EXISTS export_points (
+            generation  INTEGER NOT NULL,
+            filename    TEXT    NOT NULL,
+            exported_at INTEGER NOT NULL DEFAULT (CAST(strftime('%s','now') AS INTEGER))
         );
     )");
+    execute(R"(
+        CREATE TABLE IF NOT EXISTS change_log_prunes (
+            generation INTEGER NOT NULL,
+            rows       INTEGER NOT NULL,
+            pruned_at  INTEGER NOT NULL DEFAULT (CAST(strftime('%s','now') AS INTEGER))
+        );
+    )");
+    // Remplace l'ancien compteur sync_state
+    for (const char* table : {"students", "courses", "grades"})
+        for (const char* suffix : {"ins", "upd", "del"})
+            execute(std::string("DROP TRIGGER IF EXISTS trg_") + table + "_gen_" + suffix + ";");
+    execute("DROP TABLE IF EXISTS sync_state;");
+
+    for (const char* table : {"students", "courses", "grades"}) {
+        std::string t = table;
+        std::string log = "INSERT INTO change_log (table_name, row_id, op) ";
+        execute("CREATE TRIGGER IF NOT EXISTS trg_" + t + "_log_ins AFTER INSERT ON " + t +
+                " BEGIN " + log + "VALUES ('" + t + "', NEW.id, 'I'); END;");
+        // Changement d'ID : l'ancien disparaît
+        execute("CREATE TRIGGER IF NOT EXISTS trg_" + t + "_log_upd AFTER UPDATE ON " + t +
+                " BEGIN " + log + "SELECT '" + t + "', OLD.id, 'D' WHERE OLD.id <> NEW.id; " +
+                log + "VALUES ('" + t + "', NEW.id, 'U'); END;");
+        execute("CREATE TRIGGER IF NOT EXISTS trg_" + t + "_log_del AFTER DELETE ON " + t +
+                " BEGIN " + log + "VALUES ('" + t + "', OLD.id, 'D'); END;");
+    }
+
+    // Historique des notes (voir GRADE_HISTORY_COLUMNS)
+    execute(createTable("grade_history", GRADE_HISTORY_COLUMNS));
+    // Historique d'une note / d'un étudiant, et modifications sur une période
+    execute("CREATE INDEX IF NOT EXISTS idx_grade_history_student "
+            "ON grade_history(student_id, course_id, changed_at);");
+    execute("CREATE INDEX IF NOT EXISTS idx_grade_history_time ON grade_history(changed_at);");
+    // En disposition groupée, trg_grades_id réécrit l'insertion : une seule ligne ici
+    execute(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_grades_history_ins AFTER INSERT ON grades
+        BEGIN
+            INSERT INTO grade_history (grade_id, student_id, course_id, op, new_grade)
+            VALUES (NEW.id, NEW.student_id, NEW.course_id, 'I', NEW.grade);
+        END;
+    )");
+    execute(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_grades_history_upd
+        AFTER UPDATE OF grade, student_id, course_id ON grades
+        WHEN OLD.grade IS NOT NEW.grade OR OLD.student_id <> NEW.student_id
+          OR OLD.course_id <> NEW.course_id
+        BEGIN
+            INSERT INTO grade_history (grade_id, student_id, course_id, op, old_grade, new_grade)
+            VALUES (OLD.id, OLD.student_id, OLD.course_id, 'U', OLD.grade, NEW.grade);
+        END;
+    )");
+    execute(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_grades_history_del AFTER DELETE ON grades
+        BEGIN
+            INSERT INTO grade_history (grade_id, student_id, course_id, op, old_grade)
+            VALUES (OLD.id, OLD.student_id, OLD.course_id, 'D', OLD.grade);
+        END;
+    )");
+    execute(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_grade_history_no_update BEFORE UPDATE ON grade_history
+        BEGIN SELECT RAISE(ABORT, 'grade_history : historique en ajout seul'); END;
+    )");
+    execute(R"(
+        CREATE TRIGGER IF NOT EXISTS trg_grade_history_no_delete BEFORE DELETE ON grade_history
+        BEGIN SELECT RAISE(ABORT, 'grade_history : historique en ajout seul'); END;
+    )");
+
+    execute(createTable("import_checkpoints", IMPORT_CHECKPOINTS_COLUMNS));
+
+    // Presque toutes les lectures de notes filtrent sur l'étudiant
+    // (en disposition groupée, la clé primaire en tient lieu ; l'ID a son propre index)
+    if (gradesLayout() == GradesLayout::CLUSTERED) {
+        execute("CREATE UNIQUE INDEX IF NOT EXISTS idx_grades_id ON grades(id);");
+        execute(GRADES_ID_TRIGGER);
+    } else {
+        execute("CREATE INDEX IF NOT EXISTS idx_grades_student ON grades(student_id, course_id);");
+    }
+    // Rapports par période (jours entiers : clés de 2 ou 3 octets)
+    execute("CREATE INDEX IF NOT EXISTS idx_grades_date ON grades(date_recorded);");
+
+    // Clés de pagination des listes (voir KeysetPager)
+    execute("CREATE INDEX IF NOT EXISTS idx_students_name ON students(name);");
+    execute("CREATE INDEX IF NOT EXISTS idx_users_role ON users(role, username);");
+
+    // Recherche par préfixe insensible à la casse (LIKE 'texte%', voir RecordSelector)
+    execute("CREATE INDEX IF NOT EXISTS idx_students_name_nocase ON students(name COLLATE NOCASE);");
+    execute("CREATE INDEX IF NOT EXISTS idx_courses_name_nocase ON courses(name COLLATE NOCASE);");
+
+    // Recherche plein texte (voir FullTextSearch) : index FTS5 à contenu externe, qui ne
+    // stockent que les termes ; les triggers y reportent chaque modification
+    struct FtsTable { const char* table; const char* columns; const char* oldValues; const char* newValues; };
+    const FtsTable ftsTables[] = {
+        {"students", "name, email",       "OLD.name, OLD.email",       "NEW.name, NEW.email"},
+        {"courses",  "name, description", "OLD.name, OLD.description", "NEW.name, NEW.description"}};
+    for (const FtsTable& f : ftsTables) {
+        std::string t = f.table, cols = f.columns, fts = t + "_fts";
+        std::string oldValues = f.oldValues, newValues = f.newValues;
+        bool ftsExists = false;
+        {
+            Statement check(*this, "SELECT COUNT(*) FROM sqlite_master WHERE name = ?");
+            check.bind(1, fts);
+            ftsExists = check.step() && check.getInt(0) > 0;
+        }
+        execute("CREATE VIRTUAL TABLE IF NOT EXISTS " + fts + " USING fts5(" + cols + ", content='" + t +
+                "', content_rowid='id', tokenize='unicode61 remove_diacritics 2', prefix='2 3');");
+        std::string remove = "INSERT INTO " + fts + " (" + fts + ", rowid, " + cols +
+                             ") VALUES ('delete', OLD.id, " + oldValues + "); ";
+        std::string add = "INSERT INTO " + fts + " (rowid, " + cols + ") VALUES (NEW.id, " +
+                          newValues + "); ";
+        execute("CREATE TRIGGER IF NOT EXISTS trg_" + t + "_fts_ins AFTER INSERT ON " + t +
+                " BEGIN " + add + "END;");
+        execute("CREATE TRIGGER IF NOT EXISTS trg_" + t + "_fts_upd AFTER UPDATE OF id, " + cols +
+                " ON " + t + " BEGIN " + remove + add + "END;");
+        execute("CREATE TRIGGER IF NOT EXISTS trg_" + t + "_fts_del AFTER DELETE ON " + t +
+                " BEGIN " + remove + "END;");
+
+        // Première ouverture d'une base existante : index construit à partir de sa table,
+        // chacun selon son propre contenu (des cours peuvent exister sans étudiant)
+        if (!ftsExists && !query("SELECT 1 FROM " + t + " LIMIT 1;").empty()) {
+            auto start = std::chrono::steady_clock::now();
+            execute("INSERT INTO " + fts + " (" + fts + ") VALUES ('rebuild');");
+            std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+            std::cout << "✓ Index de recherche plein texte " << fts << " construit ("
+                      << static_cast<long long>(elapsed.count()) << " ms)\n";
+        }
+    }
 
     // Insérer les données de test seulement si la table est vide
-    auto rows = query("SELECT COUNT(*) AS nb FROM users;");
+    auto rows = testData ? query("SELECT COUNT(*) AS nb FROM users;") : ResultSet();
     if (!rows.empty() && rows[0]["nb"] == "0") {
         execute(R"(
             INSERT INTO users (username, password, role, email) VALUES
@@ -152,4 +575,158 @@ void Database::initSchema() {
 
         std::cout << "[DB] Donnees de test inserees.\n";
     }
-}
\ No newline at end of file
+}
+
+// ─── Statement ─────────────────────────────────────────────────────────────
+
+Statement::Statement(const Database& db, const std::string& sql)
+    : stmt(nullptr), lastRc(SQLITE_OK), feed(db.getFeed()) {
+    lastRc = sqlite3_prepare_v2(db.getHandle(), sql.c_str(), -1, &stmt, nullptr);
+    if (lastRc != SQLITE_OK) {
+        std::cerr << "[DB ERROR] " << sqlite3_errmsg(db.getHandle()) << std::endl;
+        stmt = nullptr;
+    }
+}
+
+Statement::~Statement() { sqlite3_finalize(stmt); }
+
+bool Statement::isValid() const { return stmt != nullptr; }
+
+bool Statement::ok() const {
+    return stmt && (lastRc == SQLITE_OK || lastRc == SQLITE_ROW || lastRc == SQLITE_DONE);
+}
+
+void Statement::bind(int index, int value)       { sqlite3_bind_int(stmt, index, value); }
+void Statement::bind(int index, long long value) { sqlite3_bind_int64(stmt, index, value); }
+void Statement::bind(int index, double value)    { sqlite3_bind_double(stmt, index, value); }
+void Statement::bindNull(int index)              { sqlite3_bind_null(stmt, index); }
+
+void Statement::bind(int index, const std::string& value) {
+    sqlite3_bind_text(stmt, index, value.c_str(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+}
+
+void Statement::bindView(int index, std::string_view value) {
+    sqlite3_bind_text(stmt, index, value.data(), static_cast<int>(value.size()), SQLITE_STATIC);
+}
+
+bool Statement::step() {
+    if (!stmt) return false;
+    size_t mark = feed ? feed->beginStatement() : 0;
+    lastRc = sqlite3_step(stmt);
+    if (lastRc == SQLITE_ROW) return true;
+    if (feed) feed->endStatement(mark, lastRc != SQLITE_DONE);
+    if (lastRc != SQLITE_DONE)
+        std::cerr << "[DB ERROR] " << sqlite3_errmsg(sqlite3_db_handle(stmt)) << std::endl;
+    return false;
+}
+
+bool Statement::run() {
+    while (step()) {}
+    return ok();
+}
+
+bool Statement::tryRun() {
+    if (!stmt) return false;
+    size_t mark = feed ? feed->beginStatement() : 0;
+    do { lastRc = sqlite3_step(stmt); } while (lastRc == SQLITE_ROW);
+    if (feed) feed->endStatement(mark, lastRc != SQLITE_DONE);
+    return lastRc == SQLITE_DONE;
+}
+
+int Statement::changes() const { return stmt ? sqlite3_changes(sqlite3_db_handle(stmt)) : 0; }
+
+const char* Statement::errorMessage() const {
+    return stmt ? sqlite3_errmsg(sqlite3_db_handle(stmt)) : "requête invalide";
+}
+
+void Statement::reset() {
+    sqlite3_reset(stmt);
+    sqlite3_clear_bindings(stmt);
+    lastRc = SQLITE_OK;
+}
+
+long long Statement::getInt(int col) const    { return sqlite3_column_int64(stmt, col); }
+double    Statement::getDouble(int col) const { return sqlite3_column_double(stmt, col); }
+bool      Statement::isNull(int col) const    { return sqlite3_column_type(stmt, col) == SQLITE_NULL; }
+
+std::string Statement::getText(int col) const {
+    auto* text = sqlite3_column_text(stmt, col);
+    return text ? std::string(reinterpret_cast<const char*>(text), sqlite3_column_bytes(stmt, col)) : "NULL";
+}
+
+Row Statement::getRow() const {
+    Row row;
+    int n = sqlite3_column_count(stmt);
+    for (int i = 0; i < n; ++i)
+        row[sqlite3_column_name(stmt, i)] = getText(i);
+    return row;
+}
+
+int         Statement::columnCount() const           { return sqlite3_column_count(stmt); }
+int         Statement::parameterCount() const        { return sqlite3_bind_parameter_count(stmt); }
+const char* Statement::columnName(int col) const     { return sqlite3_column_name(stmt, col); }
+int         Statement::columnType(int col) const     { return sqlite3_column_type(stmt, col); }
+const char* Statement::declaredType(int col) const   { return sqlite3_column_decltype(stmt, col); }
+
+std::string_view Statement::getView(int col) const {
+    auto* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, col));
+    return text ? std::string_view(text, static_cast<size_t>(sqlite3_column_bytes(stmt, col)))
+                : std::string_view();
+}
+
+// ─── ReadSnapshot ───────────────────────────────────────────────────────────
+
+// Après BEGIN, c'est la première lecture qui fixe l'état vu par la transaction
+static long long readGeneration(Database& db) {
+    // Dernier numéro attribué par AUTOINCREMENT (0 si le journal n'a jamais servi)
+    Statement stmt(db, "SELECT COALESCE((SELECT seq FROM sqlite_sequence WHERE name = 'change_log'), 0)");
+    return stmt.step() ? stmt.getInt(0) : -1;
+}
+
+ReadSnapshot::ReadSnapshot(Database& db)
+    : db(db), snapshot(nullptr), active(false), gen(-1) {
+    if (!db.begin()) return;
+    gen = readGeneration(db);
+    if (gen < 0) { db.rollback(); return; }
+    active = true;
+
+    Statement now(db, "SELECT strftime('%Y-%m-%dT%H:%M:%SZ', 'now')");
+    if (now.step()) taken = now.getText(0);
+#ifdef SQLITE_ENABLE_SNAPSHOT
+    // Échoue hors WAL : le verrou partagé suffit alors
+    if (sqlite3_snapshot_get(db.getHandle(), "main", &snapshot) != SQLITE_OK) snapshot = nullptr;
+#endif
+}
+
+ReadSnapshot::~ReadSnapshot() {
+#ifdef SQLITE_ENABLE_SNAPSHOT
+    if (snapshot) sqlite3_snapshot_free(snapshot);
+#endif
+    if (active) db.commit();
+}
+
+bool ReadSnapshot::isValid() const { return active; }
+long long ReadSnapshot::generation() const { return gen; }
+const std::string& ReadSnapshot::takenAt() const { return taken; }
+
+const char* ReadSnapshot::mode() const {
+    return snapshot ? "instantané WAL" : "génération vérifiée";
+}
+
+bool ReadSnapshot::join(Database& reader) const {
+    if (!active || !reader.begin()) return false;
+#ifdef SQLITE_ENABLE_SNAPSHOT
+    if (snapshot && sqlite3_snapshot_open(reader.getHandle(), "main", snapshot) != SQLITE_OK) {
+        std::cerr << "[DB ERROR] " << sqlite3_errmsg(reader.getHandle()) << std::endl;
+        reader.rollback();
+        return false;
+    }
+#endif
+    // Sans instantané partagé, une écriture a pu être validée depuis le début
+    if (readGeneration(reader) != gen) {
+        std::cerr << "[DB ERROR] La base a changé depuis le début de l'export." << std::endl;
+        reader.rollback();
+        return false;
+    }
+    return true;
+}
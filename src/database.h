@@ -2,7 +2,11 @@
 #define DATABASE_H
 
 #include "sqlite3.h"
+#include "changefeed.h"
+#include <functional>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <map>
 #include <iostream>
@@ -10,26 +14,156 @@
 using Row       = std::map<std::string, std::string>;
 using ResultSet = std::vector<Row>;
 
+// Disposition de la table grades. ROWID : lignes dans l'ordre d'insertion, notes d'un
+// étudiant retrouvées par idx_grades_student puis une à une dans la table. CLUSTERED :
+// WITHOUT ROWID, clé primaire (student_id, course_id, id), notes d'un étudiant côte à
+// côte ; les changements de grades n'y passent plus par le hook de mise à jour, ChangeFeed
+// les publie d'après les lignes que leurs triggers écrivent dans change_log.
+enum class GradesLayout { ROWID, CLUSTERED };
+
+class QueryCache;
+
 class Database {
 private:
-    sqlite3*    db;
-    std::string dbPath;
+    sqlite3*                    db;
+    std::string                 dbPath;
+    std::unique_ptr<ChangeFeed> feed;   // connexion principale seulement (connect())
+    bool                        testData;   // données de test insérées si la base est vide
+    std::unique_ptr<QueryCache> cache;      // facultatif, voir enableCache()
+
+    // Mise à niveau d'une base créée par une version précédente (PRAGMA user_version)
+    bool migrate();
+    bool rebuildTable(const std::string& table, const std::string& create, const std::string& select);
+    bool rebuildAll(const std::function<bool()>& steps);
 
 public:
+    // Version du schéma, notée dans PRAGMA user_version. 1 : dates en entiers (dates.h),
+    // 2 : créations de notes dans grade_history, horodatages de results et
+    // import_checkpoints en entiers
+    static constexpr int SCHEMA_VERSION = 2;
+
     explicit Database(const std::string& dbPath = "student_management.db");
     ~Database();
 
-    bool connect();
+    // withTestData = false : base vide laissée vide (remplie ensuite, ex. ShardedDatabase)
+    bool connect(bool withTestData = true);
+    bool connectReadOnly();   // Connexion secondaire (threads de calcul), sans initSchema
     void disconnect();
     bool isConnected() const;
+    const std::string& getPath() const;
+    sqlite3* getHandle() const;
 
     ResultSet   query(const std::string& sql);
+    ResultSet   query(const std::string& sql, const std::vector<std::string>& params);   // ?1, ?2... liés en texte
     bool        execute(const std::string& sql);
     int         getLastInsertId();
     std::string escape(const std::string& value);
 
+    // Transactions explicites (traitements par lots)
+    bool begin();
+    bool commit();
+    bool rollback();
+
+    // Flux des changements validés sur cette connexion (nullptr en lecture seule)
+    ChangeFeed* getFeed() const;
+    std::shared_ptr<ChangeSubscription> subscribe(size_t capacity = ChangeFeed::DEFAULT_CAPACITY);
+    void unsubscribe(const std::shared_ptr<ChangeSubscription>& subscription);
+
+    // Cache des résultats de query() (voir QueryCache), désactivé par défaut.
+    // Budget mémoire en octets ; getCache() vaut nullptr quand il est désactivé.
+    void        enableCache(size_t budgetBytes);
+    void        disableCache();
+    QueryCache* getCache() const;
+
     // Initialise les tables et données de test au premier lancement
     void initSchema();
+
+    // Disposition actuelle de grades, et passage à l'autre : table reconstruite, index et
+    // triggers recréés, tout ou rien (faux si échec, base inchangée)
+    GradesLayout gradesLayout() const;
+    bool setGradesLayout(GradesLayout layout);
+
+    // CREATE TABLE de grades dans une disposition, sous le nom donné
+    static std::string gradesTableSql(const std::string& name, GradesLayout layout);
+};
+
+// Requête préparée : lecture colonne par colonne sans passer par Row/ResultSet,
+// pour les traitements sur de gros volumes
+class Statement {
+private:
+    sqlite3_stmt* stmt;
+    int           lastRc;
+    ChangeFeed*   feed;
+
+public:
+    Statement(const Database& db, const std::string& sql);
+    ~Statement();
+
+    Statement(const Statement&) = delete;
+    Statement& operator=(const Statement&) = delete;
+
+    bool isValid() const;
+    bool ok() const;      // false si le dernier step() a échoué
+
+    void bind(int index, int value);
+    void bind(int index, long long value);
+    void bind(int index, double value);
+    void bind(int index, const std::string& value);
+    void bindNull(int index);
+    void bindView(int index, std::string_view value);   // sans copie : value doit survivre au step()
+
+    bool step();          // true tant qu'une ligne est disponible
+    bool run();           // exécute jusqu'au bout (INSERT / UPDATE / DELETE)
+    bool tryRun();        // comme run(), sans message d'erreur (rejets comptés par l'appelant)
+    int  changes() const; // lignes modifiées par la dernière exécution
+    const char* errorMessage() const;
+    void reset();
+
+    long long   getInt(int col) const;
+    double      getDouble(int col) const;
+    std::string getText(int col) const;
+    bool        isNull(int col) const;
+    Row         getRow() const;   // ligne courante au format de query()
+
+    // Accès direct aux colonnes, sans copie (valide jusqu'au prochain step())
+    int              columnCount() const;
+    int              parameterCount() const;        // paramètres ?, ?N, :nom... de la requête
+    const char*      columnName(int col) const;
+    int              columnType(int col) const;     // SQLITE_INTEGER, SQLITE_FLOAT, ...
+    const char*      declaredType(int col) const;   // type déclaré dans le schéma, nullptr si calculé
+    std::string_view getView(int col) const;
+};
+
+// Instantané de lecture : la connexion garde une transaction de lecture ouverte
+// tant que l'objet existe. En WAL, elle ne bloque jamais les écritures.
+// D'autres connexions peuvent s'y rattacher avec join() (export parallèle) :
+//  - WAL + SQLITE_ENABLE_SNAPSHOT : sqlite3_snapshot_open()
+//  - WAL sans instantanés : refus si la génération a changé entre-temps
+//  - journal classique : le verrou SHARED tenu ici bloque tout COMMIT concurrent
+class ReadSnapshot {
+private:
+    Database&         db;
+    sqlite3_snapshot* snapshot;
+    bool              active;
+    long long         gen;
+    std::string       taken;
+
+public:
+    explicit ReadSnapshot(Database& db);
+    ~ReadSnapshot();
+
+    ReadSnapshot(const ReadSnapshot&) = delete;
+    ReadSnapshot& operator=(const ReadSnapshot&) = delete;
+
+    bool isValid() const;
+    const char* mode() const;
+
+    // Point de l'instantané : génération (dernier numéro de change_log) et date de lecture (UTC)
+    long long          generation() const;
+    const std::string& takenAt() const;
+
+    // Ouvre sur reader une transaction de lecture sur le même état de la base
+    bool join(Database& reader) const;
 };
 
 #endif // DATABASE_H
\ No newline at end of file
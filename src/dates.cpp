@@ -0,0 +1,37 @@
+#include "dates.h"
+
+std::string daySql(const std::string& column) {
+    return "date(" + column + " * 86400, 'unixepoch')";
+}
+
+std::string timeSql(const std::string& column) {
+    return "datetime(" + column + ", 'unixepoch', 'localtime')";
+}
+
+static bool digits(std::string_view text, size_t pos, size_t count, int& value) {
+    value = 0;
+    for (size_t i = pos; i < pos + count; ++i) {
+        if (text[i] < '0' || text[i] > '9') return false;
+        value = value * 10 + (text[i] - '0');
+    }
+    return true;
+}
+
+bool parseDay(std::string_view text, long long& day) {
+    int y, m, d;
+    if (text.size() != 10 || text[4] != '-' || text[7] != '-') return false;
+    if (!digits(text, 0, 4, y) || !digits(text, 5, 2, m) || !digits(text, 8, 2, d)) return false;
+
+    static const int DAYS_IN_MONTH[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    if (m < 1 || m > 12 || d < 1 || d > DAYS_IN_MONTH[m - 1] + (m == 2 && leap)) return false;
+
+    // Jours depuis le 1970-01-01 (calendrier grégorien, années commençant en mars)
+    long long year = m <= 2 ? y - 1 : y;
+    long long era  = year / 400;
+    long long yoe  = year - era * 400;
+    long long doy  = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    long long doe  = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    day = era * 146097 + doe - 719468;
+    return true;
+}
@@ -0,0 +1,20 @@
+#ifndef DATES_H
+#define DATES_H
+
+#include <string>
+#include <string_view>
+
+// Dates stockées en entiers : date des notes (grades.date_recorded) en jours depuis le
+// 1970-01-01, horodatages (created_at, changed_at) en secondes Unix. Deux à cinq octets
+// au lieu de dix ou dix-neuf, et des comparaisons numériques ; le texte ISO n'apparaît
+// qu'aux bords (affichage, export, import, saisie).
+
+// Expressions SQL qui affichent une colonne en texte : "2024-03-15" (jour, UTC) ou
+// "2024-03-15 14:02:00" (horodatage, heure locale)
+std::string daySql(const std::string& column);
+std::string timeSql(const std::string& column);
+
+// "YYYY-MM-DD" → jour ; faux si le texte n'est pas une date du calendrier
+bool parseDay(std::string_view text, long long& day);
+
+#endif // DATES_H
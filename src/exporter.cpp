@@ -0,0 +1,353 @@
+#include "exporter.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+// ─── Exporter ──────────────────────────────────────────────────────────────
+
+Exporter::Exporter(FILE* file) : file(file), out(file, 1 << 20) {}
+
+Exporter::~Exporter() { close(); }
+
+bool Exporter::close() {
+    if (!file) return false;
+    out.flush();
+    bool ok = out.good();
+    ok = std::fclose(file) == 0 && ok;
+    file = nullptr;
+    return ok;
+}
+
+long long Exporter::writeSection(const ExportSection& section, Statement& stmt) {
+    if (!stmt.isValid()) return -1;
+
+    bool hasRow = stmt.step();
+    beginSection(section, stmt, hasRow);
+    long long count = 0;
+    for (; hasRow; hasRow = stmt.step()) {
+        writeRow(stmt);
+        ++count;
+    }
+    endSection();
+    return stmt.ok() ? count : -1;
+}
+
+bool Exporter::good() const { return out.good(); }
+
+unsigned long long Exporter::bytesWritten() const { return out.bytesWritten(); }
+
+// ─── Texte pipe-séparé (format historique) ─────────────────────────────────
+
+class TextExporter : public Exporter {
+private:
+    bool first = true;
+
+protected:
+    void beginSection(const ExportSection& section, const Statement&, bool) override {
+        if (!first) out.append('\n');
+        first = false;
+        out.append(section.title);
+        out.append('\n');
+        out.append(section.header);
+        out.append('\n');
+    }
+
+    void writeRow(const Statement& stmt) override {
+        int n = stmt.columnCount();
+        for (int i = 0; i < n; ++i) {
+            if (i > 0) out.append('|');
+            // Même rendu des NULL que Database::query()
+            out.append(stmt.columnType(i) == SQLITE_NULL ? "NULL" : stmt.getView(i));
+        }
+        out.append('\n');
+    }
+
+public:
+    using Exporter::Exporter;
+
+    void writeBanner(const std::string& text) override {
+        out.append(text);
+        out.append("\n\n");
+    }
+
+    void writeSnapshotPoint(long long generation, const std::string& takenAt) override {
+        out.append("# snapshot|" + std::to_string(generation) + "|" + takenAt + "\n\n");
+    }
+};
+
+// ─── CSV (RFC 4180) ────────────────────────────────────────────────────────
+
+class CsvExporter : public Exporter {
+private:
+    void field(std::string_view text) {
+        if (text.find_first_of(",\"\r\n") == std::string_view::npos) {
+            out.append(text);
+            return;
+        }
+        out.append('"');
+        size_t start = 0, quote;
+        while ((quote = text.find('"', start)) != std::string_view::npos) {
+            out.append(text.substr(start, quote - start + 1));
+            out.append('"');
+            start = quote + 1;
+        }
+        out.append(text.substr(start));
+        out.append('"');
+    }
+
+protected:
+    void beginSection(const ExportSection&, const Statement& stmt, bool) override {
+        int n = stmt.columnCount();
+        for (int i = 0; i < n; ++i) {
+            if (i > 0) out.append(',');
+            field(stmt.columnName(i));
+        }
+        out.append("\r\n");
+    }
+
+    void writeRow(const Statement& stmt) override {
+        int n = stmt.columnCount();
+        for (int i = 0; i < n; ++i) {
+            if (i > 0) out.append(',');
+            field(stmt.getView(i));   // NULL → champ vide
+        }
+        out.append("\r\n");
+    }
+
+public:
+    using Exporter::Exporter;
+
+    bool oneFilePerSection() const override { return true; }
+};
+
+// ─── JSON Lines ────────────────────────────────────────────────────────────
+
+class JsonLinesExporter : public Exporter {
+private:
+    std::vector<std::string> keys;   // ,"nom": déjà échappés, préparés une fois par section
+    std::string              prefix; // {"section":"students"
+
+    static void escapeInto(std::string& dst, std::string_view text) {
+        static const char* hex = "0123456789abcdef";
+        for (char c : text) {
+            auto u = static_cast<unsigned char>(c);
+            if (c == '"' || c == '\\') { dst += '\\'; dst += c; }
+            else if (u < 0x20) { dst += "\\u00"; dst += hex[u >> 4]; dst += hex[u & 0xF]; }
+            else dst += c;
+        }
+    }
+
+    void string(std::string_view text) {
+        out.append('"');
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            auto u = static_cast<unsigned char>(text[i]);
+            if (u >= 0x20 && text[i] != '"' && text[i] != '\\') continue;
+            out.append(text.substr(start, i - start));
+            std::string escaped;
+            escapeInto(escaped, text.substr(i, 1));
+            out.append(escaped);
+            start = i + 1;
+        }
+        out.append(text.substr(start));
+        out.append('"');
+    }
+
+protected:
+    void beginSection(const ExportSection& section, const Statement& stmt, bool) override {
+        prefix = "{\"section\":\"";
+        escapeInto(prefix, section.name);
+        prefix += '"';
+        keys.clear();
+        for (int i = 0; i < stmt.columnCount(); ++i) {
+            std::string key = ",\"";
+            escapeInto(key, stmt.columnName(i));
+            keys.push_back(key + "\":");
+        }
+    }
+
+    void writeRow(const Statement& stmt) override {
+        out.append(prefix);
+        for (int i = 0; i < static_cast<int>(keys.size()); ++i) {
+            out.append(keys[i]);
+            switch (stmt.columnType(i)) {
+                case SQLITE_NULL:    out.append("null"); break;
+                case SQLITE_INTEGER:
+                case SQLITE_FLOAT:   out.append(stmt.getView(i)); break;
+                default:             string(stmt.getView(i));
+            }
+        }
+        out.append("}\n");
+    }
+
+public:
+    using Exporter::Exporter;
+
+    void writeSnapshotPoint(long long generation, const std::string& takenAt) override {
+        out.append("{\"section\":\"snapshot\",\"generation\":" + std::to_string(generation) +
+                   ",\"taken_at\":");
+        string(takenAt);
+        out.append("}\n");
+    }
+};
+
+// ─── Binaire en colonnes typées ────────────────────────────────────────────
+//
+// Fichier : "GUCOL1\n"
+// Point   : 'P' u64 génération + u16 len + date UTC (optionnel, avant la première section)
+// Section : 'S' u16 len + nom, u16 nbColonnes, puis par colonne u8 type + u16 len + nom
+//           (type 1 = entier i64, 2 = réel f64, 3 = texte UTF-8)
+// Bloc    : 'B' u32 nbLignes, puis par colonne : bitmap des NULL (⌈n/8⌉ octets)
+//           et les valeurs (i64 × n | f64 × n | u32 × (n+1) offsets + octets)
+// Fin     : 'E' u64 nbLignesSection
+// Tous les entiers sont en little-endian.
+
+class BinaryExporter : public Exporter {
+private:
+    static constexpr uint32_t BLOCK_ROWS = 8192;
+    enum : uint8_t { INT64 = 1, FLOAT64 = 2, TEXT = 3 };
+
+    struct ColumnBuffer {
+        uint8_t               type;
+        std::vector<uint8_t>  nulls;
+        std::vector<int64_t>  ints;
+        std::vector<double>   reals;
+        std::vector<uint32_t> offsets;
+        std::string           bytes;
+    };
+
+    std::vector<ColumnBuffer> columns;
+    uint32_t                  rows = 0;
+    uint64_t                  sectionRows = 0;
+
+    template <typename T>
+    void put(T value) {
+        unsigned char raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        if (!littleEndian())
+            for (size_t i = 0; i < sizeof(T) / 2; ++i) std::swap(raw[i], raw[sizeof(T) - 1 - i]);
+        out.append(std::string_view(reinterpret_cast<const char*>(raw), sizeof(T)));
+    }
+
+    template <typename T>
+    void putArray(const std::vector<T>& values) {
+        if (littleEndian()) {
+            out.append(std::string_view(reinterpret_cast<const char*>(values.data()),
+                                        values.size() * sizeof(T)));
+        } else {
+            for (const T& v : values) put(v);
+        }
+    }
+
+    void putName(std::string_view name) {
+        put(static_cast<uint16_t>(name.size()));
+        out.append(name);
+    }
+
+    static bool littleEndian() {
+        const uint16_t probe = 1;
+        return *reinterpret_cast<const uint8_t*>(&probe) == 1;
+    }
+
+    static uint8_t typeOf(const Statement& stmt, int col, bool hasRow) {
+        std::string decl = stmt.declaredType(col) ? stmt.declaredType(col) : "";
+        if (decl.find("INT") != std::string::npos) return INT64;
+        if (decl == "REAL" || decl == "DOUBLE" || decl == "FLOAT") return FLOAT64;
+        if (!decl.empty() || !hasRow) return TEXT;
+        switch (stmt.columnType(col)) {
+            case SQLITE_INTEGER: return INT64;
+            case SQLITE_FLOAT:   return FLOAT64;
+            default:             return TEXT;
+        }
+    }
+
+    void flushBlock() {
+        if (rows == 0) return;
+        out.append('B');
+        put(rows);
+        for (auto& c : columns) {
+            out.append(std::string_view(reinterpret_cast<const char*>(c.nulls.data()), c.nulls.size()));
+            if (c.type == INT64)        putArray(c.ints);
+            else if (c.type == FLOAT64) putArray(c.reals);
+            else { putArray(c.offsets); out.append(c.bytes); }
+
+            c.nulls.clear(); c.ints.clear(); c.reals.clear(); c.bytes.clear();
+            c.offsets.assign(1, 0);
+        }
+        rows = 0;
+    }
+
+protected:
+    void beginSection(const ExportSection& section, const Statement& stmt, bool hasRow) override {
+        int n = stmt.columnCount();
+        columns.assign(static_cast<size_t>(n), ColumnBuffer{});
+        sectionRows = 0;
+
+        out.append('S');
+        putName(section.name);
+        put(static_cast<uint16_t>(n));
+        for (int i = 0; i < n; ++i) {
+            columns[i].type = typeOf(stmt, i, hasRow);
+            columns[i].offsets.assign(1, 0);
+            out.append(static_cast<char>(columns[i].type));
+            putName(stmt.columnName(i));
+        }
+    }
+
+    void writeRow(const Statement& stmt) override {
+        for (int i = 0; i < static_cast<int>(columns.size()); ++i) {
+            auto& c = columns[i];
+            bool isNull = stmt.columnType(i) == SQLITE_NULL;
+            if (rows % 8 == 0) c.nulls.push_back(0);
+            if (isNull) c.nulls.back() |= static_cast<uint8_t>(1u << (rows % 8));
+
+            if (c.type == INT64)        c.ints.push_back(isNull ? 0 : stmt.getInt(i));
+            else if (c.type == FLOAT64) c.reals.push_back(isNull ? 0.0 : stmt.getDouble(i));
+            else {
+                if (!isNull) c.bytes.append(stmt.getView(i));
+                c.offsets.push_back(static_cast<uint32_t>(c.bytes.size()));
+            }
+        }
+        ++sectionRows;
+        if (++rows == BLOCK_ROWS) flushBlock();
+    }
+
+    void endSection() override {
+        flushBlock();
+        out.append('E');
+        put(sectionRows);
+    }
+
+public:
+    explicit BinaryExporter(FILE* file) : Exporter(file) { out.append("GUCOL1\n"); }
+
+    void writeSnapshotPoint(long long generation, const std::string& takenAt) override {
+        out.append('P');
+        put(static_cast<uint64_t>(generation));
+        putName(takenAt);
+    }
+};
+
+// ─── Fabrique ──────────────────────────────────────────────────────────────
+
+std::unique_ptr<Exporter> Exporter::open(ExportFormat format, const std::string& filename) {
+    FILE* file = std::fopen(filename.c_str(), "wb");
+    if (!file) return nullptr;
+
+    switch (format) {
+        case ExportFormat::CSV:    return std::make_unique<CsvExporter>(file);
+        case ExportFormat::JSONL:  return std::make_unique<JsonLinesExporter>(file);
+        case ExportFormat::BINARY: return std::make_unique<BinaryExporter>(file);
+        default:                   return std::make_unique<TextExporter>(file);
+    }
+}
+
+const char* Exporter::extension(ExportFormat format) {
+    switch (format) {
+        case ExportFormat::CSV:    return ".csv";
+        case ExportFormat::JSONL:  return ".jsonl";
+        case ExportFormat::BINARY: return ".gucol";
+        default:                   return ".txt";
+    }
+}
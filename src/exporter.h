@@ -0,0 +1,72 @@
+#ifndef EXPORTER_H
+#define EXPORTER_H
+
+#include "database.h"
+#include "outputbuffer.h"
+#include <cstdio>
+#include <memory>
+#include <string>
+
+enum class ExportFormat {
+    TEXT,     // format historique pipe-séparé
+    CSV,      // RFC 4180, un fichier par section
+    JSONL,    // JSON Lines, un objet par ligne
+    BINARY    // colonnes typées par blocs (voir BinaryExporter dans exporter.cpp)
+};
+
+// Une section exportée : nom technique (JSON, fichiers CSV), titre et en-tête du format texte
+struct ExportSection {
+    std::string name;     // "students"
+    std::string title;    // "--- ETUDIANTS ---"
+    std::string header;   // "ID|Nom|Email|Date de naissance"
+};
+
+// Exporteur : les lignes sont lues directement sur la requête préparée et écrites
+// dans un tampon, sans passer par Row / ResultSet
+class Exporter {
+private:
+    FILE* file;
+
+protected:
+    OutputBuffer out;
+
+    // stmt est positionné sur la première ligne si hasRow
+    virtual void beginSection(const ExportSection& section, const Statement& stmt, bool hasRow) = 0;
+    virtual void writeRow(const Statement& stmt) = 0;
+    virtual void endSection() {}
+
+public:
+    explicit Exporter(FILE* file);
+    virtual ~Exporter();
+
+    Exporter(const Exporter&) = delete;
+    Exporter& operator=(const Exporter&) = delete;
+
+    // Ouvre filename et crée l'exporteur du format demandé, nullptr si échec
+    static std::unique_ptr<Exporter> open(ExportFormat format, const std::string& filename);
+    static const char* extension(ExportFormat format);
+
+    // CSV ne sait représenter qu'un tableau par fichier
+    virtual bool oneFilePerSection() const { return false; }
+
+    virtual void writeBanner(const std::string& text) { (void)text; }   // format texte seulement
+
+    // Point de l'instantané lu (génération de change_log + date UTC), en tête de fichier,
+    // pour enchaîner des exports incrémentaux. CSV n'a pas d'emplacement pour l'écrire :
+    // FileManager l'écrit alors dans un fichier <export>.snapshot.
+    virtual void writeSnapshotPoint(long long generation, const std::string& takenAt) {
+        (void)generation; (void)takenAt;
+    }
+
+    // Exporte toutes les lignes de stmt ; retourne le nombre de lignes, -1 en cas d'erreur
+    long long writeSection(const ExportSection& section, Statement& stmt);
+
+    // Vide le tampon et ferme le fichier ; faux si une écriture ou la fermeture a échoué
+    // (disque plein, erreur d'E/S). Sans appel, le destructeur ferme sans rien signaler.
+    bool close();
+
+    bool good() const;
+    unsigned long long bytesWritten() const;
+};
+
+#endif // EXPORTER_H
@@ -1,27 +1,46 @@
 #include "filemanager.h"
+#include "dates.h"
+#include "table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
 #include <fstream>
-#include <sstream>
 #include <iostream>
+#include <iomanip>
+#include <thread>
 
 FileManager::FileManager(Database& db) : db(db) {}
 
 // ─── Export public (routage selon le rôle) ─────────────────────────────────
 
+static ExportFormat askFormat() {
+    int choice = 1;
+    std::cout << "Format : [1] Texte (|)  [2] CSV  [3] JSON Lines  [4] Binaire (colonnes)\nChoix : ";
+    std::cin >> choice; std::cin.ignore();
+    switch (choice) {
+        case 2:  return ExportFormat::CSV;
+        case 3:  return ExportFormat::JSONL;
+        case 4:  return ExportFormat::BINARY;
+        default: return ExportFormat::TEXT;
+    }
+}
+
 void FileManager::exportData(User& user, int studentId) {
     std::string filename;
     std::cout << "Nom du fichier d'export (ex: export.txt) : ";
-    std::cin.ignore();
     std::getline(std::cin, filename);
+    ExportFormat format = askFormat();
 
     switch (user.getRole()) {
         case Role::ADMIN:
-            exportAll(filename);
+            exportAll(filename, format);
             break;
         case Role::PROF:
-            exportGradesOnly(filename);
+            exportGradesOnly(filename, format);
             break;
         case Role::STUDENT:
-            exportStudentInfo(filename, studentId);
+            exportStudentInfo(filename, format, studentId);
             break;
     }
 }
@@ -36,7 +55,6 @@ void FileManager::importData(User& user) {
 
     std::string filename;
     std::cout << "Nom du fichier à importer : ";
-    std::cin.ignore();
     std::getline(std::cin, filename);
 
     switch (user.getRole()) {
@@ -51,204 +69,496 @@ void FileManager::importData(User& user) {
     }
 }
 
-// ─── Export complet (Admin) ─────────────────────────────────────────────────
+// ─── Moteur d'export commun ────────────────────────────────────────────────
 
-void FileManager::exportAll(const std::string& filename) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "✗ Impossible d'ouvrir le fichier : " << filename << "\n";
-        return;
-    }
+// "export.csv" + "students" → "export_students.csv"
+static std::string sectionFilename(const std::string& filename, const std::string& section) {
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return filename + "_" + section;
+    return filename.substr(0, dot) + "_" + section + filename.substr(dot);
+}
 
-    file << "=== EXPORT COMPLET - " << filename << " ===\n\n";
+// "export.csv" → "export.csv.snapshot" : point de l'instantané d'un export CSV
+static std::string snapshotFilename(const std::string& filename) {
+    return filename + ".snapshot";
+}
 
-    // --- Étudiants ---
-    file << "--- ETUDIANTS ---\n";
-    file << "ID|Nom|Email|Date de naissance\n";
-    auto students = db.query("SELECT id, name, email, birthdate FROM students");
-    for (auto& row : students) {
-        file << row["id"] << "|" << row["name"] << "|"
-             << row["email"] << "|" << row["birthdate"] << "\n";
+long long FileManager::exportSections(const std::string& filename, ExportFormat format,
+                                      const std::vector<SectionQuery>& sections,
+                                      const std::string& banner) {
+    auto start = std::chrono::steady_clock::now();
+    long long total = 0;
+    unsigned long long bytes = 0;
+
+    // Toutes les sections sont lues dans une seule transaction de lecture
+    exportedGeneration = -1;
+    ReadSnapshot snapshot(db);
+    if (!snapshot.isValid()) {
+        std::cerr << "✗ Impossible d'ouvrir une transaction de lecture.\n";
+        return -1;
     }
 
-    // --- Cours ---
-    file << "\n--- COURS ---\n";
-    file << "ID|Nom|Description|Credits\n";
-    auto courses = db.query("SELECT id, name, description, credits FROM courses");
-    for (auto& row : courses) {
-        file << row["id"] << "|" << row["name"] << "|"
-             << row["description"] << "|" << row["credits"] << "\n";
+    std::unique_ptr<Exporter> exporter;
+    std::vector<std::string> files;
+    for (auto& [section, sql] : sections) {
+        if (!exporter || exporter->oneFilePerSection()) {
+            std::string target = filename;
+            if (exporter) {
+                bool closed = exporter->close();
+                bytes += exporter->bytesWritten();
+                if (!closed) {
+                    std::cerr << "✗ Erreur d'écriture.\n";
+                    return -1;
+                }
+            }
+            if (format == ExportFormat::CSV && sections.size() > 1)
+                target = sectionFilename(filename, section.name);
+            exporter = Exporter::open(format, target);
+            if (!exporter) {
+                std::cerr << "✗ Impossible d'ouvrir le fichier : " << target << "\n";
+                return -1;
+            }
+            files.push_back(target);
+            if (!banner.empty()) exporter->writeBanner(banner);
+            exporter->writeSnapshotPoint(snapshot.generation(), snapshot.takenAt());
+        }
+
+        Statement stmt(db, sql);
+        long long rows = exporter->writeSection(section, stmt);
+        if (rows < 0) return -1;
+        total += rows;
+    }
+    bool ok = exporter->close();
+    bytes += exporter->bytesWritten();
+    if (!ok) {
+        std::cerr << "✗ Erreur d'écriture.\n";
+        return -1;
     }
 
-    // --- Notes ---
-    file << "\n--- NOTES ---\n";
-    file << "ID|Etudiant|Cours|Note|Date\n";
-    auto grades = db.query(
-        "SELECT g.id, s.name AS student, c.name AS course, g.grade, g.date_recorded "
-        "FROM grades g "
-        "JOIN students s ON g.student_id = s.id "
-        "JOIN courses  c ON g.course_id  = c.id");
-    for (auto& row : grades) {
-        file << row["id"] << "|" << row["student"] << "|"
-             << row["course"] << "|" << row["grade"] << "|" << row["date_recorded"] << "\n";
+    // Le CSV n'a pas d'en-tête : point de l'instantané et fichiers produits à côté,
+    // même format que le manifeste de l'export parallèle
+    if (format == ExportFormat::CSV) {
+        std::string sidecar = snapshotFilename(filename);
+        std::ofstream out(sidecar);
+        if (!banner.empty()) out << banner << "\n";
+        out << "snapshot|" << snapshot.generation() << "|" << snapshot.takenAt() << "\n";
+        for (const std::string& file : files) out << "fichier|" << file << "\n";
+        out.close();
+        if (!out) {
+            std::cerr << "✗ Impossible d'écrire le point de l'instantané : " << sidecar << "\n";
+            return -1;
+        }
     }
 
-    file.close();
-    std::cout << "✓ Export complet → " << filename << "\n";
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  " << total << " ligne(s), " << std::fixed << std::setprecision(1)
+              << bytes / 1e6 << " Mo en " << std::setprecision(2) << elapsed.count() << " s";
+    if (elapsed.count() > 0)
+        std::cout << " (" << std::setprecision(0) << bytes / 1e6 / elapsed.count() << " Mo/s)";
+    std::cout << "\n  Instantané : génération " << snapshot.generation()
+              << " (" << snapshot.takenAt() << ")\n";
+    exportedGeneration = snapshot.generation();
+    return total;
 }
 
-// ─── Export notes seules (Prof) ────────────────────────────────────────────
+// ─── Export complet (Admin) ─────────────────────────────────────────────────
+
+static const ExportSection STUDENTS_SECTION = {"students", "--- ETUDIANTS ---", "ID|Nom|Email|Date de naissance"};
+static const ExportSection COURSES_SECTION  = {"courses",  "--- COURS ---",     "ID|Nom|Description|Credits"};
+static const ExportSection GRADES_SECTION   = {"grades",   "--- NOTES ---",     "ID|Etudiant|Cours|Note|Date"};
+
+static const char* STUDENTS_EXPORT_SQL = "SELECT id, name, email, birthdate FROM students";
+static const char* COURSES_EXPORT_SQL  = "SELECT id, name, description, credits FROM courses";
+static const std::string GRADES_EXPORT_SQL =
+    "SELECT g.id, s.name AS student, c.name AS course, g.grade, "
+    + daySql("g.date_recorded") + " AS date_recorded "
+    "FROM grades g "
+    "JOIN students s ON g.student_id = s.id "
+    "JOIN courses  c ON g.course_id  = c.id";
+
+void FileManager::exportAll(const std::string& filename, ExportFormat format) {
+    std::vector<SectionQuery> sections = {
+        {STUDENTS_SECTION, STUDENTS_EXPORT_SQL},
+        {COURSES_SECTION,  COURSES_EXPORT_SQL},
+        {GRADES_SECTION,   GRADES_EXPORT_SQL}};
+
+    if (exportSections(filename, format, sections, "=== EXPORT COMPLET - " + filename + " ===") >= 0) {
+        recordExportPoint(filename);
+        std::cout << "✓ Export complet → " << filename << "\n";
+    }
+}
+
+// ─── Export différentiel (Admin) ───────────────────────────────────────────
 
-void FileManager::exportGradesOnly(const std::string& filename, int studentId) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "✗ Impossible d'ouvrir le fichier.\n";
+void FileManager::exportDeltaData(User& user) {
+    if (user.getRole() != Role::ADMIN) {
+        std::cout << "Export différentiel réservé à l'administrateur.\n";
         return;
     }
+    std::string filename;
+    long long since = 0;
+    std::cout << "Nom du fichier d'export (ex: delta.txt) : ";
+    std::getline(std::cin, filename);
+    std::cout << "Depuis la génération (en-tête du dernier export, 0 = tout) : ";
+    std::cin >> since; std::cin.ignore();
+    exportDelta(filename, askFormat(), std::max(0LL, since));
+}
 
-    file << "--- NOTES ---\n";
-    file << "ID|Etudiant|Cours|Note|Date\n";
+// Génération jusqu'à laquelle change_log a été purgé (0 : jamais)
+static long long prunedGeneration(Database& db) {
+    Statement stmt(db, "SELECT IFNULL(MAX(generation), 0) FROM change_log_prunes");
+    return stmt.step() ? stmt.getInt(0) : 0;
+}
 
-    std::string sql =
-        "SELECT g.id, s.name AS student, c.name AS course, g.grade, g.date_recorded "
-        "FROM grades g "
-        "JOIN students s ON g.student_id = s.id "
-        "JOIN courses  c ON g.course_id  = c.id";
+void FileManager::recordExportPoint(const std::string& filename) {
+    if (exportedGeneration < 0) return;
+    Statement insert(db, "INSERT INTO export_points (generation, filename) VALUES (?, ?)");
+    insert.bind(1, exportedGeneration);
+    insert.bind(2, filename);
+    insert.run();
+}
 
-    if (studentId > 0)
-        sql += " WHERE g.student_id = " + std::to_string(studentId);
+// Lignes modifiées depuis since (état courant) + IDs supprimés depuis (tombstones)
+static std::string changedIds(const char* table, long long since) {
+    return std::string("SELECT row_id FROM change_log WHERE table_name = '") + table +
+           "' AND seq > " + std::to_string(since);
+}
 
-    auto grades = db.query(sql);
-    for (auto& row : grades) {
-        file << row["id"] << "|" << row["student"] << "|"
-             << row["course"] << "|" << row["grade"] << "|" << row["date_recorded"] << "\n";
-    }
+static std::string tombstonesSql(const char* table, long long since) {
+    return std::string("SELECT DISTINCT c.row_id AS id FROM change_log c "
+                       "WHERE c.table_name = '") + table + "' AND c.seq > " + std::to_string(since) +
+           " AND NOT EXISTS (SELECT 1 FROM " + table + " t WHERE t.id = c.row_id)";
+}
 
-    file.close();
-    std::cout << "✓ Export notes → " << filename << "\n";
+void FileManager::exportDelta(const std::string& filename, ExportFormat format, long long since) {
+    long long pruned = prunedGeneration(db);
+    if (since < pruned) {
+        std::cout << "✗ Journal purgé jusqu'à la génération " << pruned << " : export différentiel "
+                  << "impossible depuis " << since << ", faire un export complet.\n";
+        return;
+    }
+    std::vector<SectionQuery> sections = {
+        {STUDENTS_SECTION, std::string(STUDENTS_EXPORT_SQL) + " WHERE id IN (" + changedIds("students", since) + ")"},
+        {COURSES_SECTION,  std::string(COURSES_EXPORT_SQL)  + " WHERE id IN (" + changedIds("courses", since) + ")"},
+        {GRADES_SECTION,   std::string(GRADES_EXPORT_SQL)   + " WHERE g.id IN (" + changedIds("grades", since) + ")"},
+        {{"students_deleted", "--- ETUDIANTS SUPPRIMES ---", "ID"}, tombstonesSql("students", since)},
+        {{"courses_deleted",  "--- COURS SUPPRIMES ---",     "ID"}, tombstonesSql("courses", since)},
+        {{"grades_deleted",   "--- NOTES SUPPRIMEES ---",    "ID"}, tombstonesSql("grades", since)}};
+
+    std::string banner = "=== EXPORT DIFFERENTIEL depuis la génération " + std::to_string(since) +
+                         " - " + filename + " ===";
+    if (exportSections(filename, format, sections, banner) >= 0) {
+        recordExportPoint(filename);
+        std::cout << "✓ Export différentiel → " << filename << "\n";
+    }
 }
 
-// ─── Export infos étudiant (Student) ───────────────────────────────────────
+// ─── Export complet parallèle (Admin) ──────────────────────────────────────
 
-void FileManager::exportStudentInfo(const std::string& filename, int studentId) {
-    std::ofstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "✗ Impossible d'ouvrir le fichier.\n";
+// "export.csv" → "export.manifest"
+static std::string manifestFilename(const std::string& filename) {
+    size_t dot = filename.find_last_of('.');
+    size_t slash = filename.find_last_of("/\\");
+    if (dot == std::string::npos || (slash != std::string::npos && dot < slash))
+        return filename + ".manifest";
+    return filename.substr(0, dot) + ".manifest";
+}
+
+void FileManager::exportDataParallel(User& user) {
+    if (user.getRole() != Role::ADMIN) {
+        std::cout << "Export parallèle réservé à l'administrateur.\n";
         return;
     }
+    std::string filename;
+    std::cout << "Nom du fichier d'export (ex: export.csv) : ";
+    std::getline(std::cin, filename);
+    exportParallel(filename, askFormat());
+    recordExportPoint(manifestFilename(filename));
+}
 
-    // Infos personnelles
-    auto info = db.query(
-        "SELECT name, email, birthdate FROM students WHERE id=" + std::to_string(studentId));
+void FileManager::exportParallel(const std::string& filename, ExportFormat format) {
+    auto start = std::chrono::steady_clock::now();
 
-    if (!info.empty()) {
-        file << "=== MES INFORMATIONS ===\n";
-        file << "Nom       : " << info[0]["name"]      << "\n";
-        file << "Email     : " << info[0]["email"]     << "\n";
-        file << "Naissance : " << info[0]["birthdate"] << "\n\n";
+    // Toutes les connexions lisent le même état de la base
+    exportedGeneration = -1;
+    ReadSnapshot snapshot(db);
+    if (!snapshot.isValid()) {
+        std::cerr << "✗ Impossible d'ouvrir une transaction de lecture.\n";
+        return;
     }
 
-    // Notes
-    file << "=== MES NOTES ===\n";
-    file << "Cours|Note|Date\n";
-    auto grades = db.query(
-        "SELECT c.name AS course, g.grade, g.date_recorded "
-        "FROM grades g "
-        "JOIN courses c ON g.course_id = c.id "
-        "WHERE g.student_id = " + std::to_string(studentId));
+    // Découpage : une tâche par petite section, les notes en tranches d'IDs
+    std::vector<ExportPart> parts;
+    parts.emplace_back(STUDENTS_SECTION, STUDENTS_EXPORT_SQL);
+    parts.emplace_back(COURSES_SECTION,  COURSES_EXPORT_SQL);
+
+    unsigned nThreads = std::max(1u, std::thread::hardware_concurrency());
+    Statement bounds(db, "SELECT MIN(id), MAX(id) FROM grades");
+    if (bounds.step() && !bounds.isNull(0)) {
+        long long lo    = bounds.getInt(0);
+        long long hi    = bounds.getInt(1);
+        long long span  = hi - lo + 1;
+        long long n     = std::min<long long>(span, nThreads * 2LL);
+        long long step  = (span + n - 1) / n;
+        for (long long first = lo; first <= hi; first += step) {
+            ExportPart part(GRADES_SECTION,
+                            std::string(GRADES_EXPORT_SQL) + " WHERE g.id BETWEEN ?1 AND ?2");
+            part.ranged = true;
+            part.first  = first;
+            part.last   = std::min(first + step - 1, hi);
+            parts.push_back(part);
+        }
+    } else {
+        parts.emplace_back(GRADES_SECTION, GRADES_EXPORT_SQL);
+    }
 
-    for (auto& row : grades) {
-        file << row["course"] << "|" << row["grade"] << "|" << row["date_recorded"] << "\n";
+    int chunk = 0;
+    for (auto& part : parts) {
+        std::string suffix = part.section.name;
+        if (part.ranged) {
+            std::string num = std::to_string(++chunk);
+            suffix += "_" + std::string(num.size() < 3 ? 3 - num.size() : 0, '0') + num;
+        }
+        part.file = sectionFilename(filename, suffix);
     }
 
-    file.close();
-    std::cout << "✓ Export mes données → " << filename << "\n";
+    // Un thread = une connexion en lecture seule rattachée à l'instantané
+    unsigned nWorkers = std::min<unsigned>(nThreads, static_cast<unsigned>(parts.size()));
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < nWorkers; ++t) {
+        workers.emplace_back([&]() {
+            Database reader(db.getPath());
+            if (!reader.connectReadOnly() || !snapshot.join(reader)) return;
+            for (size_t i = next++; i < parts.size(); i = next++) {
+                ExportPart& part = parts[i];
+                auto exporter = Exporter::open(format, part.file);
+                if (!exporter) continue;
+                Statement stmt(reader, part.sql);
+                if (part.ranged) {
+                    stmt.bind(1, part.first);
+                    stmt.bind(2, part.last);
+                }
+                long long rows = exporter->writeSection(part.section, stmt);
+                bool ok = exporter->close();   // dernière écriture du tampon comprise
+                part.bytes = exporter->bytesWritten();
+                if (ok) part.rows = rows;
+            }
+            reader.commit();
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // Manifeste : liste des fichiers produits, dans l'ordre de lecture
+    long long total = 0;
+    unsigned long long bytes = 0;
+    int failed = 0;
+    std::string manifest = manifestFilename(filename);
+    std::ofstream out(manifest);
+    out << "=== EXPORT PARALLELE - " << filename << " ===\n";
+    out << "format|" << Exporter::extension(format) + 1 << "\n";
+    out << "lecture|" << snapshot.mode() << "\n";
+    out << "snapshot|" << snapshot.generation() << "|" << snapshot.takenAt() << "\n";
+    out << "section|fichier|lignes|octets|premier_id|dernier_id\n";
+    for (auto& part : parts) {
+        if (part.rows < 0) {
+            std::cerr << "✗ Échec de l'export : " << part.file << "\n";
+            ++failed;
+            continue;
+        }
+        out << part.section.name << "|" << part.file << "|" << part.rows << "|" << part.bytes << "|";
+        if (part.ranged) out << part.first << "|" << part.last;
+        else             out << "|";
+        out << "\n";
+        total += part.rows;
+        bytes += part.bytes;
+    }
+    out.close();
+    if (!out || failed > 0) {
+        std::cerr << "✗ Export parallèle incomplet (" << failed << " fichier(s) en échec).\n";
+        return;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  " << total << " ligne(s), " << std::fixed << std::setprecision(1)
+              << bytes / 1e6 << " Mo en " << std::setprecision(2) << elapsed.count() << " s, "
+              << parts.size() << " fichier(s), " << nWorkers << " thread(s)";
+    if (elapsed.count() > 0)
+        std::cout << " (" << std::setprecision(0) << bytes / 1e6 / elapsed.count() << " Mo/s)";
+    std::cout << "\n✓ Export parallèle → " << manifest << "\n";
+    exportedGeneration = snapshot.generation();
+}
+
+// ─── Export notes seules (Prof) ────────────────────────────────────────────
+
+void FileManager::exportGradesOnly(const std::string& filename, ExportFormat format, int studentId) {
+    std::string sql = GRADES_EXPORT_SQL;
+
+    if (studentId > 0)
+        sql += " WHERE g.student_id = " + std::to_string(studentId);
+
+    if (exportSections(filename, format, {{GRADES_SECTION, sql}}) >= 0)
+        std::cout << "✓ Export notes → " << filename << "\n";
+}
+
+// ─── Export infos étudiant (Student) ───────────────────────────────────────
+
+void FileManager::exportStudentInfo(const std::string& filename, ExportFormat format, int studentId) {
+    std::string id = std::to_string(studentId);
+    std::vector<SectionQuery> sections = {
+        {{"info", "=== MES INFORMATIONS ===", "Nom|Email|Naissance"},
+         "SELECT name, email, birthdate FROM students WHERE id=" + id},
+        {{"grades", "=== MES NOTES ===", "Cours|Note|Date"},
+         "SELECT c.name AS course, g.grade, " + daySql("g.date_recorded") + " AS date_recorded "
+         "FROM grades g "
+         "JOIN courses c ON g.course_id = c.id "
+         "WHERE g.student_id = " + id}};
+
+    if (exportSections(filename, format, sections) >= 0)
+        std::cout << "✓ Export mes données → " << filename << "\n";
+}
+
+// ─── Import (BulkImporter) ─────────────────────────────────────────────────
+
+static void printImportStats(const char* label, const ImportStats& stats) {
+    long long rows = stats.imported + stats.ignored + stats.rejected;
+    std::cout << "✓ " << label << " — " << stats.imported << " ligne(s) importée(s), "
+              << stats.ignored << " ignorée(s) (déjà présentes), "
+              << stats.rejected << " rejetée(s)\n"
+              << "  " << rows << " ligne(s) de données en " << std::fixed << std::setprecision(2)
+              << stats.seconds << " s";
+    if (stats.seconds > 0)
+        std::cout << " (" << std::setprecision(0) << rows / stats.seconds << " lignes/s)";
+    std::cout << "\n  " << stats.cores << " cœur(s) utilisé(s) : "
+              << stats.parsers << " thread(s) d'analyse + 1 writer\n";
+    if (stats.resumedOffset >= 0)
+        std::cout << "  Import repris en passe " << stats.resumedPass + 1 << " à l'octet "
+                  << stats.resumedOffset << " (lignes précédentes déjà validées)\n";
 }
 
 // ─── Import complet (Admin) ─────────────────────────────────────────────────
 
 void FileManager::importAll(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "✗ Fichier introuvable : " << filename << "\n";
+    ImportStats stats;
+    BulkImporter importer(db, {ImportSection::STUDENTS, ImportSection::COURSES, ImportSection::GRADES});
+    if (importer.importFile(filename, stats))
+        printImportStats("Import terminé", stats);
+}
+
+// ─── Synchronisation (Admin) ───────────────────────────────────────────────
+
+void FileManager::syncData(User& user) {
+    if (user.getRole() != Role::ADMIN) {
+        std::cout << "Synchronisation réservée à l'administrateur.\n";
         return;
     }
+    std::string filename, confirm;
+    std::cout << "Fichier de référence (ex: export.txt) : ";
+    std::getline(std::cin, filename);
+    std::cout << "Les lignes absentes du fichier seront supprimées des tables qu'il contient "
+                 "(sans section NOTES, étudiants et cours notés conservés). Continuer ? (o/n) : ";
+    std::getline(std::cin, confirm);
+    if (confirm == "o" || confirm == "O") syncAll(filename);
+    else std::cout << "Synchronisation annulée.\n";
+}
 
-    std::string section;
-    std::string line;
-    int imported = 0;
-
-    while (std::getline(file, line)) {
-        // Ignorer lignes vides et commentaires
-        if (line.empty() || line[0] == '=' || line[0] == 'I') continue;
+void FileManager::syncAll(const std::string& filename) {
+    ImportStats stats;
+    BulkImporter importer(db, {ImportSection::STUDENTS, ImportSection::COURSES, ImportSection::GRADES});
+    if (!importer.syncFile(filename, stats)) return;
+
+    std::cout << "✓ Synchronisation terminée — " << stats.imported << " ajoutée(s), "
+              << stats.updated << " modifiée(s), " << stats.deleted << " supprimée(s), "
+              << stats.ignored << " inchangée(s), " << stats.rejected << " rejetée(s)\n";
+    if (stats.kept > 0)
+        std::cout << "  " << stats.kept << " ligne(s) absente(s) du fichier conservée(s) : "
+                  << "notes liées, non synchronisées\n";
+    std::cout << "  " << stats.imported + stats.updated + stats.deleted << " écriture(s) pour "
+              << stats.lines << " ligne(s) lue(s) en " << std::fixed << std::setprecision(2)
+              << stats.seconds << " s\n";
+}
 
-        if (line == "--- ETUDIANTS ---") { section = "students"; continue; }
-        if (line == "--- COURS ---")     { section = "courses";  continue; }
-        if (line == "--- NOTES ---")     { section = "grades";   continue; }
+// ─── Purge du journal des changements (Admin) ──────────────────────────────
 
-        // Parser les champs pipe-séparés
-        std::vector<std::string> fields;
-        std::stringstream ss(line);
-        std::string field;
-        while (std::getline(ss, field, '|')) fields.push_back(field);
+static constexpr std::array<Column, 3> EXPORT_POINT_COLUMNS = {{
+    {"Génération", "generation", 12}, {"Exporté le", "exported", 21}, {"Fichier", "filename", 40}}};
 
-        if (section == "students" && fields.size() == 4) {
-            std::string sql = "INSERT IGNORE INTO students (id, name, email, birthdate) VALUES ("
-                + db.escape(fields[0]) + ", '"
-                + db.escape(fields[1]) + "', '"
-                + db.escape(fields[2]) + "', '"
-                + db.escape(fields[3]) + "')";
-            if (db.execute(sql)) ++imported;
-        }
-        else if (section == "courses" && fields.size() == 4) {
-            std::string sql = "INSERT IGNORE INTO courses (id, name, description, credits) VALUES ("
-                + db.escape(fields[0]) + ", '"
-                + db.escape(fields[1]) + "', '"
-                + db.escape(fields[2]) + "', "
-                + db.escape(fields[3]) + ")";
-            if (db.execute(sql)) ++imported;
+void FileManager::pruneChangeLogData(User& user) {
+    if (user.getRole() != Role::ADMIN) {
+        std::cout << "Purge du journal réservée à l'administrateur.\n";
+        return;
+    }
+    long long pruned = prunedGeneration(db);
+    Statement size(db, "SELECT COUNT(*), IFNULL(MIN(seq), 0), IFNULL(MAX(seq), 0) FROM change_log");
+    if (!size.step()) return;
+    std::cout << "\nJournal des changements : " << size.getInt(0) << " ligne(s), générations "
+              << size.getInt(1) << " à " << size.getInt(2);
+    if (pruned > 0) std::cout << " (purgé jusqu'à " << pruned << ")";
+    std::cout << "\n";
+    size.reset();
+
+    // Un destinataire d'export n'a besoin que des changements postérieurs à son export
+    ResultSet points = db.query("SELECT generation, " + timeSql("exported_at") + " AS exported, filename "
+                                "FROM export_points WHERE generation > " + std::to_string(pruned) +
+                                " ORDER BY generation DESC, rowid DESC LIMIT 10");
+    if (points.empty()) {
+        std::cout << "Aucun export depuis la dernière purge : faire d'abord un export complet.\n";
+        return;
+    }
+    std::cout << "\nDerniers exports (base des exports différentiels suivants) :";
+    printTable(EXPORT_POINT_COLUMNS, points);
+
+    Statement newest(db, "SELECT MAX(generation) FROM export_points");
+    long long latest = newest.step() ? newest.getInt(0) : pruned;
+    newest.reset();
+    std::string text, confirm;
+    std::cout << "\nPurger jusqu'à la génération (Entrée = " << latest << ", dernier export) : ";
+    std::getline(std::cin, text);
+    long long upTo = latest;
+    if (!text.empty()) {
+        char* end = nullptr;
+        upTo = std::strtoll(text.c_str(), &end, 10);
+        if (*end != '\0' || upTo <= pruned || upTo > latest) {
+            std::cout << "✗ Génération invalide (entre " << pruned + 1 << " et " << latest << ").\n";
+            return;
         }
     }
+    std::cout << "Les exports différentiels depuis une génération antérieure à " << upTo
+              << " seront refusés. Continuer ? (o/n) : ";
+    std::getline(std::cin, confirm);
+    if (confirm != "o" && confirm != "O") {
+        std::cout << "Purge annulée.\n";
+        return;
+    }
 
-    file.close();
-    std::cout << "✓ Import terminé — " << imported << " ligne(s) importée(s).\n";
+    auto start = std::chrono::steady_clock::now();
+    if (!db.begin()) return;
+    Statement remove(db, "DELETE FROM change_log WHERE seq <= ?");
+    remove.bind(1, upTo);
+    bool ok = remove.run();
+    long long rows = remove.changes();
+    Statement note(db, "INSERT INTO change_log_prunes (generation, rows) VALUES (?, ?)");
+    note.bind(1, upTo);
+    note.bind(2, rows);
+    ok = ok && note.run();
+    if (!ok || !db.commit()) {
+        db.rollback();
+        std::cout << "✗ Échec de la purge, journal inchangé.\n";
+        return;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "✓ " << rows << " ligne(s) du journal supprimée(s) jusqu'à la génération " << upTo
+              << " en " << std::fixed << std::setprecision(2) << elapsed.count() << " s\n";
 }
 
 // ─── Import notes seules (Prof) ────────────────────────────────────────────
 
 void FileManager::importGradesOnly(const std::string& filename) {
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        std::cerr << "✗ Fichier introuvable.\n";
-        return;
-    }
-
-    // Format attendu : student_id|course_id|grade
-    std::string line;
-    int imported = 0;
-    bool inGrades = false;
-
-    while (std::getline(file, line)) {
-        if (line == "--- NOTES ---") { inGrades = true; continue; }
-        if (!inGrades || line.empty() || line[0] == 'I') continue;
-
-        std::vector<std::string> fields;
-        std::stringstream ss(line);
-        std::string field;
-        while (std::getline(ss, field, '|')) fields.push_back(field);
-
-        // Format : id|student|course|grade|date  → on skippe l'en-tête
-        if (fields.size() >= 4 && fields[0] != "ID") {
-            // Utilisation directe des IDs si on a un import structuré
-            // Format simplifié pour le prof : student_id|course_id|note
-            std::string sql = "INSERT INTO grades (student_id, course_id, grade) VALUES ("
-                + db.escape(fields[0]) + ", "
-                + db.escape(fields[1]) + ", "
-                + db.escape(fields[2]) + ")";
-            if (db.execute(sql)) ++imported;
-        }
-    }
-
-    file.close();
-    std::cout << "✓ Import notes — " << imported << " ligne(s) importée(s).\n";
+    // Format attendu : student_id|course_id|note sous "--- NOTES ---"
+    ImportStats stats;
+    BulkImporter importer(db, {ImportSection::GRADES});
+    if (importer.importFile(filename, stats))
+        printImportStats("Import notes", stats);
 }
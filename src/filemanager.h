@@ -3,19 +3,55 @@
 
 #include "user.h"
 #include "database.h"
+#include "exporter.h"
+#include "importer.h"
 #include <string>
+#include <vector>
 
 class FileManager {
 private:
     Database& db;
+    long long exportedGeneration = -1;   // génération lue par le dernier export réussi
+
+    // Une section = sa description + la requête qui la produit
+    using SectionQuery = std::pair<ExportSection, std::string>;
+
+    // Écrit les sections dans filename (ou un fichier par section en CSV).
+    // Retourne le nombre de lignes exportées, -1 en cas d'erreur.
+    long long exportSections(const std::string& filename, ExportFormat format,
+                             const std::vector<SectionQuery>& sections,
+                             const std::string& banner = "");
+
+    // Export parallèle : un fichier par section ou tranche d'IDs de notes
+    struct ExportPart {
+        ExportSection      section;
+        std::string        sql;          // avec "?1" / "?2" pour les bornes si ranged
+        bool               ranged = false;
+        long long          first  = 0;
+        long long          last   = 0;
+        std::string        file;
+        long long          rows   = -1;  // -1 : échec
+        unsigned long long bytes  = 0;
+
+        ExportPart(ExportSection section, std::string sql)
+            : section(std::move(section)), sql(std::move(sql)) {}
+    };
+
+    void exportParallel(const std::string& filename, ExportFormat format);
+    void exportDelta(const std::string& filename, ExportFormat format, long long since);
+
+    // Export complet ou différentiel réussi : base possible d'un prochain export
+    // différentiel (proposée à la purge du journal). Après la fin de l'instantané.
+    void recordExportPoint(const std::string& filename);
 
     // Helpers internes
-    void exportAll(const std::string& filename);
-    void exportGradesOnly(const std::string& filename, int studentId = -1);
-    void exportStudentInfo(const std::string& filename, int studentId);
+    void exportAll(const std::string& filename, ExportFormat format);
+    void exportGradesOnly(const std::string& filename, ExportFormat format, int studentId = -1);
+    void exportStudentInfo(const std::string& filename, ExportFormat format, int studentId);
 
     void importAll(const std::string& filename);
     void importGradesOnly(const std::string& filename);
+    void syncAll(const std::string& filename);
 
 public:
     explicit FileManager(Database& db);
@@ -23,8 +59,23 @@ public:
     // Export selon le rôle
     void exportData(User& user, int studentId = -1);
 
+    // Export complet en parallèle (Admin) : fichiers par section + manifeste
+    void exportDataParallel(User& user);
+
+    // Export différentiel (Admin) : lignes ajoutées / modifiées / supprimées depuis
+    // une génération (celle indiquée en tête d'un export précédent)
+    void exportDeltaData(User& user);
+
     // Import selon le rôle
     void importData(User& user);
+
+    // Synchronisation (Admin) : le fichier devient l'état des tables qu'il contient ;
+    // seules les lignes ajoutées, modifiées ou absentes sont écrites
+    void syncData(User& user);
+
+    // Purge du journal des changements (Admin) jusqu'à une génération choisie parmi les
+    // exports enregistrés ; les exports différentiels antérieurs sont ensuite refusés
+    void pruneChangeLogData(User& user);
 };
 
 #endif // FILEMANAGER_H
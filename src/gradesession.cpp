@@ -0,0 +1,175 @@
+#include "gradesession.h"
+#include "records.h"
+#include "results.h"
+#include "selector.h"
+#include "table.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+
+GradeSession::GradeSession(Database& db, int courseId, PrefixIndex* studentNames)
+    : db(db), studentNames(studentNames), courseId(courseId) {
+    if (auto record = CourseRepository(db).find(courseId)) course = record->name;
+}
+
+bool GradeSession::parseGrade(const std::string& text, double& grade) {
+    std::string value = text;
+    std::replace(value.begin(), value.end(), ',', '.');
+    if (value.empty()) return false;
+    char* end = nullptr;
+    grade = std::strtod(value.c_str(), &end);
+    return *end == '\0' && grade >= 0 && grade <= 20;
+}
+
+static constexpr std::array<Column, 3> STUDENT_MATCH_COLUMNS = {{
+    {"ID", "id", 9}, {"Nom", "name", 30}, {"Email", "email", 30}}};
+
+static constexpr std::array<Column, 3> PENDING_COLUMNS = {{
+    {"ID", "id", 9}, {"Étudiant", "student", 30}, {"Note", "grade", 6}}};
+
+int GradeSession::resolveStudent(const std::string& text, std::string& name) {
+    ResultSet matches = RecordSelector(db, studentNames).searchStudents(text);
+    if (matches.empty()) {
+        std::cout << "  ✗ Aucun étudiant ne correspond à « " << text << " ».\n";
+        return -1;
+    }
+    // Un ID exact ou une seule correspondance
+    if (matches.size() > 1 && matches[0]["id"] != text) {
+        std::cout << "  ✗ Plusieurs étudiants correspondent, précisez (ou saisissez l'ID) :";
+        printTable(STUDENT_MATCH_COLUMNS, matches);
+        return -1;
+    }
+    name = matches[0]["name"];
+    return std::stoi(matches[0]["id"]);
+}
+
+// "durand 12 14,5" : le dernier mot est la note, le reste désigne l'étudiant
+void GradeSession::add(const std::string& line) {
+    size_t split = line.find_last_of(' ');
+    if (split == std::string::npos) {
+        std::cout << "  ✗ Format : <étudiant> <note>  (ex. « durand 12 14,5 » ou « 1042 15 »)\n";
+        return;
+    }
+    double grade;
+    if (!parseGrade(line.substr(split + 1), grade)) {
+        std::cout << "  ✗ Note invalide : « " << line.substr(split + 1) << " » (0 à 20)\n";
+        return;
+    }
+    std::string name;
+    int studentId = resolveStudent(line.substr(0, line.find_last_not_of(' ', split) + 1), name);
+    if (studentId < 0) return;
+
+    // Déjà saisi dans cette session : la nouvelle note remplace l'ancienne
+    auto same = std::find_if(pending.begin(), pending.end(),
+                             [&](const Entry& e) { return e.studentId == studentId; });
+    if (same != pending.end()) {
+        std::cout << "  ↺ " << name << " : " << same->grade << " remplacée par " << grade << "\n";
+        pending.erase(same);
+    } else {
+        std::cout << "  ✓ " << name << " : " << grade;
+        Statement previous(db, "SELECT grade FROM grades WHERE student_id = ? AND course_id = ? "
+                               "ORDER BY id DESC LIMIT 1");
+        previous.bind(1, studentId);
+        previous.bind(2, courseId);
+        if (previous.step()) std::cout << "  (déjà noté " << previous.getText(0) << " dans ce cours)";
+        std::cout << "\n";
+    }
+    pending.push_back({studentId, name, grade});
+}
+
+void GradeSession::undo() {
+    if (pending.empty()) {
+        std::cout << "  Rien à annuler.\n";
+        return;
+    }
+    std::cout << "  ↶ Annulée : " << pending.back().student << " " << pending.back().grade << "\n";
+    pending.pop_back();
+}
+
+void GradeSession::list() const {
+    if (pending.empty()) {
+        std::cout << "  Aucune note en attente.\n";
+        return;
+    }
+    TableRenderer<3> table(PENDING_COLUMNS);
+    table.header();
+    for (const Entry& e : pending) {
+        char grade[32];
+        std::snprintf(grade, sizeof grade, "%g", e.grade);
+        table.row({std::to_string(e.studentId), e.student, grade});
+    }
+    table.flush();
+    std::cout << "  " << pending.size() << " note(s) en attente.\n";
+}
+
+bool GradeSession::commit() {
+    if (pending.empty()) return true;
+    auto start = std::chrono::steady_clock::now();
+
+    // Notes et résultats des étudiants concernés : tout ou rien
+    if (!db.begin()) return false;
+    Statement insert(db, "INSERT INTO grades (student_id, course_id, grade) VALUES (?, ?, ?)");
+    ResultsEngine engine(db);
+    bool ok = insert.isValid();
+    for (size_t i = 0; ok && i < pending.size(); ++i) {
+        insert.bind(1, pending[i].studentId);
+        insert.bind(2, courseId);
+        insert.bind(3, pending[i].grade);
+        ok = insert.run();
+        insert.reset();
+    }
+    for (size_t i = 0; ok && i < pending.size(); ++i) ok = engine.refreshStudent(pending[i].studentId);
+
+    if (!ok || !db.commit()) {
+        db.rollback();
+        std::cout << "✗ Échec de l'enregistrement, aucune note écrite (saisies conservées).\n";
+        return false;
+    }
+    std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "✓ " << pending.size() << " note(s) enregistrée(s) en une transaction ("
+              << static_cast<long long>(elapsed.count()) << " ms)\n";
+    pending.clear();
+    return true;
+}
+
+void GradeSession::run() {
+    if (course.empty()) {
+        std::cout << "Cours introuvable.\n";
+        return;
+    }
+    std::cout << "\n-- Saisie des notes : " << course << " --\n"
+              << "Une ligne par note : <étudiant> <note>  (nom, email ou ID ; ex. « durand 12 14,5 »)\n"
+              << "[u] annuler la dernière  [l] lister  [v] valider  Entrée = terminer\n";
+
+    std::string line;
+    while (true) {
+        std::cout << "[" << pending.size() << "] > ";
+        if (!std::getline(std::cin, line)) line.clear();
+        line.erase(0, line.find_first_not_of(' '));
+        line.erase(line.find_last_not_of(" \r") + 1);
+
+        if (line == "u")      undo();
+        else if (line == "l") list();
+        else if (line == "v") commit();
+        else if (!line.empty()) add(line);
+        else {
+            if (pending.empty()) break;
+            if (!std::cin) {
+                std::cout << "\nSaisie interrompue, aucune note enregistrée.\n";
+                break;
+            }
+            std::string answer;
+            std::cout << "Enregistrer les " << pending.size()
+                      << " note(s) en attente ? (o = oui, n = abandonner, Entrée = reprendre) : ";
+            std::getline(std::cin, answer);
+            if (answer == "o" || answer == "O") {
+                if (commit()) break;
+            } else if (answer == "n" || answer == "N") {
+                std::cout << "Saisie abandonnée, aucune note enregistrée.\n";
+                break;
+            }
+        }
+    }
+}
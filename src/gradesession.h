@@ -0,0 +1,45 @@
+#ifndef GRADESESSION_H
+#define GRADESESSION_H
+
+#include "database.h"
+#include "prefixindex.h"
+#include <string>
+#include <vector>
+
+// Saisie groupée des notes d'un cours : le cours est choisi une fois, puis chaque ligne
+// "étudiant note" est vérifiée dès la saisie et mise en attente. Les notes en attente
+// sont écrites ensemble, en une seule transaction, à la validation ; jusque-là la base
+// n'est pas verrouillée et la dernière saisie peut être annulée.
+class GradeSession {
+public:
+    struct Entry {
+        int         studentId;
+        std::string student;   // nom affiché
+        double      grade;
+    };
+
+private:
+    Database&          db;
+    PrefixIndex*       studentNames;
+    int                courseId;
+    std::string        course;
+    std::vector<Entry> pending;
+
+    // Étudiant désigné par text (ID, nom ou email) ; -1 si aucun ou plusieurs
+    int  resolveStudent(const std::string& text, std::string& name);
+    void add(const std::string& line);
+    void undo();
+    void list() const;
+    bool commit();
+
+public:
+    GradeSession(Database& db, int courseId, PrefixIndex* studentNames = nullptr);
+
+    // Note sur 20 ("12.5" ou "12,5") ; faux si invalide ou hors de 0 à 20
+    static bool parseGrade(const std::string& text, double& grade);
+
+    // Boucle de saisie, jusqu'à validation ou abandon
+    void run();
+};
+
+#endif // GRADESESSION_H
@@ -0,0 +1,113 @@
+#include "gradeslayout.h"
+#include "table.h"
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace {
+
+constexpr std::array<Column, 4> LAYOUT_COLUMNS = {{
+    {"Disposition", "layout", 36}, {"Pages lues", "pages", 12}, {"Durée (µs)", "micros", 12},
+    {"Notes", "rows", 8}}};
+
+struct LookupCost {
+    double pages  = 0;   // par consultation
+    double micros = 0;
+    double rows   = 0;
+};
+
+const char* layoutName(GradesLayout layout) {
+    return layout == GradesLayout::CLUSTERED ? "groupée (WITHOUT ROWID)" : "rowid";
+}
+
+// Notes d'un étudiant, comme Student::viewMyGrades ou un relevé
+LookupCost measure(const Database& reader, const std::string& table, const std::vector<long long>& ids) {
+    LookupCost cost;
+    Statement stmt(reader, "SELECT course_id, grade, date_recorded FROM " + table + " WHERE student_id = ?");
+    if (!stmt.isValid() || ids.empty()) return cost;
+
+    sqlite3* handle = reader.getHandle();
+    int current = 0, highwater = 0;
+    for (long long id : ids) {
+        sqlite3_db_release_memory(handle);   // cache vide : chaque page utile est relue
+        sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_MISS, &current, &highwater, 1);
+        auto start = std::chrono::steady_clock::now();
+        stmt.bind(1, id);
+        while (stmt.step()) ++cost.rows;
+        stmt.reset();
+        std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        sqlite3_db_status(handle, SQLITE_DBSTATUS_CACHE_MISS, &current, &highwater, 1);
+        cost.pages  += current;
+        cost.micros += elapsed.count();
+    }
+    auto n = static_cast<double>(ids.size());
+    cost.pages  /= n;
+    cost.micros /= n;
+    cost.rows   /= n;
+    return cost;
+}
+
+} // namespace
+
+bool benchmarkGradesLayout(Database& db, size_t lookups) {
+    GradesLayout current = db.gradesLayout();
+    GradesLayout other   = current == GradesLayout::ROWID ? GradesLayout::CLUSTERED : GradesLayout::ROWID;
+    std::string  copyPath = db.getPath() + ".layout-bench";
+    std::remove(copyPath.c_str());
+
+    std::vector<long long> ids;
+    {
+        Statement pick(db, "SELECT id FROM students ORDER BY random() LIMIT ?");
+        pick.bind(1, static_cast<long long>(lookups));
+        while (pick.step()) ids.push_back(pick.getInt(0));
+    }
+    if (ids.empty()) { std::cout << "Aucun étudiant.\n"; return false; }
+
+    // Copie dans l'ordre de la disposition d'arrivée, avec l'index qu'elle utilise.
+    // Clés étrangères suspendues : la copie n'a pas de tables parentes.
+    std::cout << "Copie des notes en disposition " << layoutName(other) << "...\n";
+    auto start = std::chrono::steady_clock::now();
+    db.execute("PRAGMA foreign_keys = OFF;");
+    bool copied = db.execute("ATTACH DATABASE '" + db.escape(copyPath) + "' AS bench;");
+    copied = copied
+        && db.execute(Database::gradesTableSql("bench.grades", other))
+        && db.execute(std::string("INSERT INTO bench.grades SELECT id, student_id, course_id, grade, "
+                                  "date_recorded FROM main.grades ORDER BY ") +
+                      (other == GradesLayout::CLUSTERED ? "student_id, course_id, id;" : "id;"))
+        && (other == GradesLayout::CLUSTERED ||
+            db.execute("CREATE INDEX bench.idx_grades_student ON grades(student_id, course_id);"));
+    db.execute("DETACH DATABASE bench;");
+    db.execute("PRAGMA foreign_keys = ON;");
+    std::chrono::duration<double> copyTime = std::chrono::steady_clock::now() - start;
+
+    LookupCost here, there;
+    if (copied) {
+        // Connexion à part : son cache ne sert qu'aux mesures
+        Database reader(db.getPath());
+        copied = reader.connectReadOnly() &&
+                 reader.execute("ATTACH DATABASE '" + reader.escape(copyPath) + "' AS bench;");
+        if (copied) {
+            here  = measure(reader, "main.grades", ids);
+            there = measure(reader, "bench.grades", ids);
+        }
+    }
+    std::remove(copyPath.c_str());
+    if (!copied) { std::cout << "✗ Copie impossible, mesure abandonnée.\n"; return false; }
+
+    std::cout << "\n" << ids.size() << " étudiants tirés au hasard, cache vide à chaque consultation "
+              << "(copie : " << std::fixed << std::setprecision(1) << copyTime.count() << " s)";
+    TableRenderer<4> table(LAYOUT_COLUMNS);
+    table.header();
+    auto row = [&table](const std::string& name, const LookupCost& c) {
+        char pages[32], micros[32], rows[32];
+        std::snprintf(pages, sizeof pages, "%.1f", c.pages);
+        std::snprintf(micros, sizeof micros, "%.0f", c.micros);
+        std::snprintf(rows, sizeof rows, "%.1f", c.rows);
+        table.row({name, pages, micros, rows});
+    };
+    row(std::string(layoutName(current)) + " (actuelle)", here);
+    row(layoutName(other), there);
+    return true;
+}
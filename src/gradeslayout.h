@@ -0,0 +1,14 @@
+#ifndef GRADESLAYOUT_H
+#define GRADESLAYOUT_H
+
+#include "database.h"
+#include <cstddef>
+
+// Compare les deux dispositions de grades (voir GradesLayout) sur la lecture des notes
+// d'un étudiant : pages lues et durée par consultation, pour `lookups` étudiants tirés
+// au hasard. La disposition actuelle est mesurée en place ; l'autre est copiée, le temps
+// de la mesure, dans un fichier voisin de la base (supprimé ensuite). Chaque consultation
+// part d'un cache vide : les pages lues sont les défauts de cache de la connexion.
+bool benchmarkGradesLayout(Database& db, size_t lookups);
+
+#endif // GRADESLAYOUT_H
@@ -0,0 +1,1192 @@
+#include "importer.h"
+#include "boundedqueue.h"
+#include "dates.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMPORTER_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// ─── MappedFile ────────────────────────────────────────────────────────────
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& filename)
+    : bytes(nullptr), length(0), opened(false), fileHandle(INVALID_HANDLE_VALUE), mapping(nullptr) {
+    fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size)) return;
+    length = static_cast<size_t>(size.QuadPart);
+    opened = true;
+    if (length == 0) return;
+
+    mapping = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping) bytes = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    opened = bytes != nullptr;
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) UnmapViewOfFile(bytes);
+    if (mapping) CloseHandle(mapping);
+    if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& filename) : bytes(nullptr), length(0), opened(false) {
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) return;
+    struct stat info;
+    if (fstat(fd, &info) == 0) {
+        length = static_cast<size_t>(info.st_size);
+        opened = true;
+        if (length > 0) {
+            void* map = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (map == MAP_FAILED) {
+                opened = false;
+            } else {
+                madvise(map, length, MADV_SEQUENTIAL);
+                bytes = static_cast<const char*>(map);
+            }
+        }
+    }
+    ::close(fd);   // la projection reste valide après close()
+}
+
+MappedFile::~MappedFile() {
+    if (bytes) munmap(const_cast<char*>(bytes), length);
+}
+
+#endif
+
+bool        MappedFile::isOpen() const { return opened; }
+const char* MappedFile::data() const   { return bytes; }
+size_t      MappedFile::size() const   { return bytes ? length : 0; }
+
+// ─── DelimiterScanner ──────────────────────────────────────────────────────
+
+static int lowestBit(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+DelimiterScanner::DelimiterScanner(const char* begin, const char* end)
+    : block(begin), end(end), mask(0) {
+    if (block < end) load();
+}
+
+void DelimiterScanner::load() {
+    mask = 0;
+    ptrdiff_t n = std::min<ptrdiff_t>(end - block, 16);
+#ifdef IMPORTER_SSE2
+    if (n == 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        __m128i hits  = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('|')),
+                                     _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')));
+        mask = static_cast<uint32_t>(_mm_movemask_epi8(hits));
+        return;
+    }
+#endif
+    // Fin de tampon (ou pas de SSE2) : même masque, octet par octet
+    for (ptrdiff_t i = 0; i < n; ++i)
+        if (block[i] == '|' || block[i] == '\n') mask |= 1u << i;
+}
+
+const char* DelimiterScanner::next() {
+    while (mask == 0) {
+        if (end - block <= 16) { block = end; return end; }
+        block += 16;
+        load();
+    }
+    const char* pos = block + lowestBit(mask);
+    mask &= mask - 1;
+    return pos;
+}
+
+// ─── Analyse des champs ────────────────────────────────────────────────────
+
+static bool parseInt(std::string_view text, long long& value) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+static bool parseDouble(std::string_view text, double& value) {
+    auto [ptr, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    return ec == std::errc() && ptr == text.data() + text.size();
+}
+
+static bool isNullField(std::string_view text) { return text == "NULL"; }
+
+static ImportSection sectionOf(std::string_view title) {
+    if (title == "--- ETUDIANTS ---") return ImportSection::STUDENTS;
+    if (title == "--- COURS ---")     return ImportSection::COURSES;
+    if (title == "--- NOTES ---")     return ImportSection::GRADES;
+    return ImportSection::NONE;
+}
+
+namespace {
+
+// ─── Lots analysés (produits par les threads d'analyse) ────────────────────
+
+// Ligne validée ; les textes pointent dans le fichier projeté (aucune copie)
+struct ParsedRow {
+    ImportSection    section;
+    size_t           offset;     // position de la ligne dans le fichier
+    long long        ids[3];     // id | student_id, course_id, id de la note
+    long long        credits;
+    double           grade;
+    long long        day;        // date de la note (jours, voir dates.h) ; NULL : bit 0 de nulls
+    std::string_view text[3];    // nom, email / description, naissance
+    uint8_t          nulls;      // bit i : text[i] vaut NULL
+    bool             byName;     // note au format d'export (ID de note + date fournis)
+};
+
+struct Rejection {
+    size_t      offset;
+    std::string reason;
+};
+
+struct ParsedBatch {
+    size_t                           index = 0;    // rang de la tranche : écriture dans l'ordre
+    std::vector<ParsedRow>           rows;
+    std::vector<Rejection>           rejections;   // les MAX_REPORTED premières seulement
+    std::map<std::string, long long> unresolved;   // « étudiant inconnu "X" » → nb de lignes
+    long long                        rejected       = 0;
+    long long                        unresolvedRows = 0;
+    long long                        lines          = 0;
+
+    void reject(size_t offset, const char* reason) {
+        if (rejected++ < BulkImporter::MAX_REPORTED) rejections.push_back({offset, reason});
+    }
+};
+
+// ─── Résolution des noms (notes au format d'export) ────────────────────────
+
+// Tables de hachage nom / email → ID, chargées depuis la base à la première note
+// qui en a besoin, puis lues sans verrou par tous les threads d'analyse
+class NameResolver {
+public:
+    static constexpr long long UNKNOWN   = 0;
+    static constexpr long long AMBIGUOUS = -1;   // nom porté par plusieurs étudiants
+
+private:
+    using IdMap = std::unordered_map<std::string, long long>;
+
+    std::string    dbPath;
+    std::once_flag loaded;
+    IdMap          studentNames;
+    IdMap          studentEmails;
+    IdMap          courseNames;
+
+    static void add(IdMap& map, std::string_view key, long long id) {
+        auto [it, inserted] = map.emplace(std::string(key), id);
+        if (!inserted && it->second != id) it->second = AMBIGUOUS;
+    }
+
+    static long long find(const IdMap& map, std::string_view key) {
+        auto it = map.find(std::string(key));
+        return it == map.end() ? UNKNOWN : it->second;
+    }
+
+    void load(const Database& source) {
+        Statement students(source, "SELECT id, name, email FROM students");
+        while (students.step()) {
+            add(studentNames, students.getView(1), students.getInt(0));
+            if (!students.isNull(2)) add(studentEmails, students.getView(2), students.getInt(0));
+        }
+        Statement courses(source, "SELECT id, name FROM courses");
+        while (courses.step()) add(courseNames, courses.getView(1), courses.getInt(0));
+    }
+
+    void load() {
+        Database reader(dbPath);
+        if (reader.connectReadOnly()) load(reader);
+    }
+
+public:
+    explicit NameResolver(std::string dbPath) : dbPath(std::move(dbPath)) {}
+
+    // Chargement immédiat depuis une connexion précise (transaction en cours comprise),
+    // avant le démarrage des threads d'analyse
+    void preload(const Database& source) {
+        std::call_once(loaded, [&]() { load(source); });
+    }
+
+    // ID trouvé, UNKNOWN ou AMBIGUOUS ; key est un nom ou un email
+    long long student(std::string_view key) {
+        std::call_once(loaded, [this]() { load(); });
+        return key.find('@') != std::string_view::npos ? find(studentEmails, key)
+                                                       : find(studentNames, key);
+    }
+
+    long long course(std::string_view key) {
+        std::call_once(loaded, [this]() { load(); });
+        return find(courseNames, key);
+    }
+};
+
+using BatchPtr = std::unique_ptr<ParsedBatch>;
+
+// Début d'une section : position de la ligne qui suit le titre
+struct SectionMark {
+    size_t        bodyStart;
+    ImportSection section;
+};
+
+// Tranche [begin, end) à analyser, alignée sur les fins de ligne
+struct Chunk {
+    size_t        begin;
+    size_t        end;
+    ImportSection section;        // section en cours au début de la tranche
+    bool          expectHeader;   // la tranche commence juste après un titre
+};
+
+// Repère les titres "--- X ---" en début de ligne
+std::vector<SectionMark> findSections(std::string_view text) {
+    std::vector<SectionMark> marks;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        if (text.compare(pos, 3, "---") == 0) {
+            size_t eol = text.find('\n', pos);
+            size_t bodyStart = eol == std::string_view::npos ? text.size() : eol + 1;
+            std::string_view title = text.substr(pos, bodyStart - pos);
+            while (!title.empty() && (title.back() == '\n' || title.back() == '\r'))
+                title.remove_suffix(1);
+            marks.push_back({bodyStart, sectionOf(title)});
+        }
+        size_t next = text.find("\n---", pos);
+        if (next == std::string_view::npos) break;
+        pos = next + 1;
+    }
+    return marks;
+}
+
+// Tranches à partir de start (début de fichier, ou point de reprise aligné sur une ligne)
+std::vector<Chunk> splitChunks(std::string_view text, const std::vector<SectionMark>& marks,
+                               size_t start) {
+    std::vector<Chunk> chunks;
+    size_t begin = start;
+    while (begin < text.size()) {
+        size_t end = std::min(begin + BulkImporter::CHUNK_BYTES, text.size());
+        if (end < text.size()) {
+            size_t eol = text.find('\n', end);
+            end = eol == std::string_view::npos ? text.size() : eol + 1;
+        }
+        // Dernier titre situé avant la tranche
+        auto after = std::upper_bound(marks.begin(), marks.end(), begin,
+            [](size_t pos, const SectionMark& m) { return pos < m.bodyStart; });
+        Chunk chunk{begin, end, ImportSection::NONE, false};
+        if (after != marks.begin()) {
+            chunk.section      = std::prev(after)->section;
+            chunk.expectHeader = std::prev(after)->bodyStart == begin;
+        }
+        chunks.push_back(chunk);
+        begin = end;
+    }
+    return chunks;
+}
+
+// Tranches à relire pour une passe : celles qui touchent l'une de ses sections
+std::vector<Chunk> chunksFor(std::string_view text, const std::vector<SectionMark>& marks,
+                             const std::vector<ImportSection>& sections, size_t start) {
+    std::vector<Chunk> work;
+    for (const Chunk& c : splitChunks(text, marks, start)) {
+        bool touches = std::find(sections.begin(), sections.end(), c.section) != sections.end();
+        for (const SectionMark& m : marks)
+            if (m.bodyStart > c.begin && m.bodyStart <= c.end &&
+                std::find(sections.begin(), sections.end(), m.section) != sections.end())
+                touches = true;
+        if (touches) work.push_back(c);
+    }
+    return work;
+}
+
+// ─── Analyse d'une tranche ─────────────────────────────────────────────────
+
+class ChunkParser {
+private:
+    const char*                       base;
+    const std::vector<ImportSection>& accepted;
+    NameResolver&                     names;
+    ParsedBatch&                      batch;
+
+    // false (et nom compté comme non résolu) si l'ID n'a pas été trouvé
+    bool resolved(long long id, const char* what, std::string_view name) {
+        if (id > 0) return true;
+        ++batch.unresolved[std::string(what) + (id == NameResolver::AMBIGUOUS ? " ambigu" : " inconnu")
+                           + " « " + std::string(name) + " »"];
+        return false;
+    }
+
+    static void setText(ParsedRow& row, int i, std::string_view text) {
+        row.text[i] = text;
+        if (isNullField(text)) row.nulls |= static_cast<uint8_t>(1u << i);
+    }
+
+    void student(const std::string_view* f, int n, ParsedRow& row) {
+        long long id;
+        if (n != 4)                            return batch.reject(row.offset, "4 champs attendus");
+        if (!parseInt(f[0], id) || id <= 0)    return batch.reject(row.offset, "ID invalide");
+        if (f[1].empty() || isNullField(f[1])) return batch.reject(row.offset, "nom manquant");
+        row.ids[0] = id;
+        for (int i = 0; i < 3; ++i) setText(row, i, f[i + 1]);
+        batch.rows.push_back(row);
+    }
+
+    void course(const std::string_view* f, int n, ParsedRow& row) {
+        long long id, credits;
+        if (n != 4)                                  return batch.reject(row.offset, "4 champs attendus");
+        if (!parseInt(f[0], id) || id <= 0)          return batch.reject(row.offset, "ID invalide");
+        if (f[1].empty() || isNullField(f[1]))       return batch.reject(row.offset, "nom manquant");
+        if (!parseInt(f[3], credits) || credits < 0) return batch.reject(row.offset, "crédits invalides");
+        row.ids[0]  = id;
+        row.credits = credits;
+        setText(row, 0, f[1]);
+        setText(row, 1, f[2]);
+        batch.rows.push_back(row);
+    }
+
+    void grade(const std::string_view* f, int n, ParsedRow& row) {
+        if (n == 5) return gradeByName(f, row);
+        if (n != 3) return batch.reject(row.offset, "3 ou 5 champs attendus");
+        if (!parseInt(f[0], row.ids[0]) || !parseInt(f[1], row.ids[1]))
+            return batch.reject(row.offset, "ID étudiant / cours invalide");
+        if (!parseDouble(f[2], row.grade) || row.grade < 0 || row.grade > 20)
+            return batch.reject(row.offset, "note invalide (0 à 20)");
+        batch.rows.push_back(row);
+    }
+
+    // id|étudiant|cours|note|date, tel qu'écrit par l'export
+    void gradeByName(const std::string_view* f, ParsedRow& row) {
+        if (!parseInt(f[0], row.ids[2]) || row.ids[2] <= 0)
+            return batch.reject(row.offset, "ID de note invalide");
+        if (!parseDouble(f[3], row.grade) || row.grade < 0 || row.grade > 20)
+            return batch.reject(row.offset, "note invalide (0 à 20)");
+        row.ids[0] = names.student(f[1]);
+        row.ids[1] = names.course(f[2]);
+        bool studentFound = resolved(row.ids[0], "étudiant", f[1]);
+        bool courseFound  = resolved(row.ids[1], "cours", f[2]);
+        if (!studentFound || !courseFound) {
+            ++batch.rejected;
+            ++batch.unresolvedRows;
+            return;
+        }
+        if (f[4].empty() || isNullField(f[4])) row.nulls |= 1u;
+        else if (!parseDay(f[4], row.day)) return batch.reject(row.offset, "date invalide (AAAA-MM-JJ)");
+        row.byName = true;
+        batch.rows.push_back(row);
+    }
+
+public:
+    ChunkParser(const char* base, const std::vector<ImportSection>& accepted,
+                NameResolver& names, ParsedBatch& batch)
+        : base(base), accepted(accepted), names(names), batch(batch) {}
+
+    void parse(const Chunk& chunk) {
+        const char* cursor = base + chunk.begin;
+        const char* end    = base + chunk.end;
+        DelimiterScanner scanner(cursor, end);
+
+        std::string_view fields[BulkImporter::MAX_FIELDS];
+        int  n = 0;
+        const char* lineStart = cursor;
+        ImportSection section = chunk.section;
+        bool active = std::find(accepted.begin(), accepted.end(), section) != accepted.end();
+        bool expectHeader = chunk.expectHeader;
+
+        while (cursor < end) {
+            const char* delim = scanner.next();
+            if (n < BulkImporter::MAX_FIELDS) fields[n] = std::string_view(cursor, delim - cursor);
+            ++n;
+            cursor = delim == end ? end : delim + 1;
+            if (delim != end && *delim == '|') continue;
+
+            // Fin de ligne : n champs dans fields
+            int count = n;
+            n = 0;
+            size_t offset = static_cast<size_t>(lineStart - base);
+            lineStart = cursor;
+            std::string_view& last = fields[std::min(count, BulkImporter::MAX_FIELDS) - 1];
+            if (!last.empty() && last.back() == '\r') last.remove_suffix(1);
+
+            std::string_view first = fields[0];
+            if (count == 1 && (first.empty() || first[0] == '=')) continue;
+            if (!first.empty() && first[0] == '#') continue;
+            if (count == 1 && first.rfind("---", 0) == 0) {
+                section = sectionOf(first);
+                active = std::find(accepted.begin(), accepted.end(), section) != accepted.end();
+                expectHeader = true;
+                continue;
+            }
+            if (!active) continue;
+            ++batch.lines;
+
+            // En-tête de section : premier champ non numérique ("ID", "student_id"...)
+            long long probe;
+            if (expectHeader) {
+                expectHeader = false;
+                if (!parseInt(first, probe)) continue;
+            }
+            if (count > BulkImporter::MAX_FIELDS) count = BulkImporter::MAX_FIELDS + 1;
+
+            ParsedRow row{};
+            row.section = section;
+            row.offset  = offset;
+            switch (section) {
+                case ImportSection::STUDENTS: student(fields, count, row); break;
+                case ImportSection::COURSES:  course(fields, count, row);  break;
+                case ImportSection::GRADES:   grade(fields, count, row);   break;
+                default: break;
+            }
+        }
+    }
+};
+
+// ─── Writer : requêtes préparées + transactions par lots ───────────────────
+
+void bindText(Statement& stmt, int index, const ParsedRow& row, int i) {
+    if (row.nulls & (1u << i)) stmt.bindNull(index);
+    else                       stmt.bindView(index, row.text[i]);
+}
+
+// "INSERT ... VALUES (?,?,?,?),(?,?,?,?)..." : ROWS_PER_INSERT lignes de 4 colonnes
+std::string multiRowInsert(const char* head) {
+    std::string sql = head;
+    for (size_t i = 0; i < BulkImporter::ROWS_PER_INSERT; ++i) sql += i ? ",(?,?,?,?)" : " VALUES (?,?,?,?)";
+    return sql;
+}
+
+void bindDay(Statement& stmt, int index, const ParsedRow& row) {
+    if (row.nulls & 1u) stmt.bindNull(index);
+    else                stmt.bind(index, row.day);
+}
+
+void bindStudent(Statement& stmt, int base, const ParsedRow& row) {
+    stmt.bind(base + 1, row.ids[0]);
+    for (int i = 0; i < 3; ++i) bindText(stmt, base + i + 2, row, i);
+}
+
+void bindCourse(Statement& stmt, int base, const ParsedRow& row) {
+    stmt.bind(base + 1, row.ids[0]);
+    bindText(stmt, base + 2, row, 0);
+    bindText(stmt, base + 3, row, 1);
+    stmt.bind(base + 4, row.credits);
+}
+
+class ImportWriter {
+private:
+    Database&    db;
+    ImportStats& stats;
+    Statement    insertStudent;
+    Statement    insertCourse;
+    Statement    insertStudents;   // ROWS_PER_INSERT lignes par requête
+    Statement    insertCourses;
+    Statement    insertGrade;
+    Statement    insertExportedGrade;
+    Statement    saveCheckpoint;
+
+    Statement& bindRow(const ParsedRow& row) {
+        switch (row.section) {
+            case ImportSection::STUDENTS:
+                bindStudent(insertStudent, 0, row);
+                return insertStudent;
+            case ImportSection::COURSES:
+                bindCourse(insertCourse, 0, row);
+                return insertCourse;
+            default:
+                if (row.byName) {
+                    insertExportedGrade.bind(1, row.ids[2]);
+                    insertExportedGrade.bind(2, row.ids[0]);
+                    insertExportedGrade.bind(3, row.ids[1]);
+                    insertExportedGrade.bind(4, row.grade);
+                    bindDay(insertExportedGrade, 5, row);
+                    return insertExportedGrade;
+                }
+                insertGrade.bind(1, row.ids[0]);
+                insertGrade.bind(2, row.ids[1]);
+                insertGrade.bind(3, row.grade);
+                return insertGrade;
+        }
+    }
+
+    // Une ligne, une requête
+    void writeOne(const ParsedRow& row) {
+        Statement& stmt = bindRow(row);
+        // Note sans ID : INSERT simple, réussi = importé (en disposition groupée, la ligne
+        // est écrite par trg_grades_id et changes() vaut 0)
+        bool plainInsert = row.section == ImportSection::GRADES && !row.byName;
+        if (stmt.tryRun()) {
+            if (plainInsert || stmt.changes() > 0) ++stats.imported;
+            else                    ++stats.ignored;
+        } else {
+            ++stats.rejected;
+            rejections.push_back({row.offset, stmt.errorMessage()});
+        }
+        stmt.reset();
+    }
+
+    // Étudiants ou cours consécutifs : ROWS_PER_INSERT lignes par requête. Chaque requête
+    // qui déclenche les triggers de l'index plein texte lui fait vider ses termes en attente
+    // (savepoint de requête) : une requête par ligne diviserait le débit par trois.
+    void writeGroup(const ParsedRow* rows, size_t n) {
+        if (n == BulkImporter::ROWS_PER_INSERT) {
+            bool students   = rows[0].section == ImportSection::STUDENTS;
+            Statement& stmt = students ? insertStudents : insertCourses;
+            for (size_t i = 0; i < n; ++i)
+                (students ? bindStudent : bindCourse)(stmt, static_cast<int>(i) * 4, rows[i]);
+            bool ok      = stmt.tryRun();
+            long long changed = stmt.changes();
+            stmt.reset();
+            if (ok) {
+                stats.imported += changed;
+                stats.ignored  += static_cast<long long>(n) - changed;
+                return;
+            }
+        }
+        // Reste du lot, ou requête en échec : ligne à ligne pour situer le rejet
+        for (size_t i = 0; i < n; ++i) writeOne(rows[i]);
+    }
+
+public:
+    std::vector<Rejection>           rejections;
+    std::map<std::string, long long> unresolved;
+
+    ImportWriter(Database& db, ImportStats& stats)
+        : db(db), stats(stats),
+          insertStudent(db, "INSERT OR IGNORE INTO students (id, name, email, birthdate) "
+                            "VALUES (?1, ?2, ?3, ?4)"),
+          insertCourse(db, "INSERT OR IGNORE INTO courses (id, name, description, credits) "
+                           "VALUES (?1, ?2, ?3, ?4)"),
+          insertStudents(db, multiRowInsert("INSERT OR IGNORE INTO students (id, name, email, birthdate)")),
+          insertCourses(db, multiRowInsert("INSERT OR IGNORE INTO courses (id, name, description, credits)")),
+          insertGrade(db, "INSERT INTO grades (student_id, course_id, grade) VALUES (?1, ?2, ?3)"),
+          // Même ID de note : réimporter un export ne duplique pas les notes
+          insertExportedGrade(db, "INSERT OR IGNORE INTO grades "
+                                  "(id, student_id, course_id, grade, date_recorded) "
+                                  "VALUES (?1, ?2, ?3, ?4, ?5)"),
+          saveCheckpoint(db, "INSERT INTO import_checkpoints "
+                             "(file_hash, sections, filename, pass, byte_offset, rows_done) "
+                             "VALUES (?1, ?2, ?3, ?4, ?5, ?6) "
+                             "ON CONFLICT(file_hash, sections) DO UPDATE SET "
+                             "filename = excluded.filename, pass = excluded.pass, "
+                             "byte_offset = excluded.byte_offset, "
+                             "rows_done = rows_done + excluded.rows_done, "
+                             "updated_at = CAST(strftime('%s','now') AS INTEGER)") {}
+
+    bool isValid() const {
+        return insertStudent.isValid() && insertCourse.isValid() && insertStudents.isValid()
+            && insertCourses.isValid() && insertGrade.isValid() && insertExportedGrade.isValid()
+            && saveCheckpoint.isValid();
+    }
+
+    // Écrit un lot dans la transaction en cours
+    void write(const ParsedBatch& batch) {
+        stats.lines    += batch.lines;
+        stats.rejected += batch.rejected;
+        stats.unresolved += batch.unresolvedRows;
+        rejections.insert(rejections.end(), batch.rejections.begin(), batch.rejections.end());
+        for (auto& [name, count] : batch.unresolved) unresolved[name] += count;
+
+        const std::vector<ParsedRow>& rows = batch.rows;
+        for (size_t i = 0; i < rows.size();) {
+            if (rows[i].section == ImportSection::GRADES) { writeOne(rows[i++]); continue; }
+            size_t j = i + 1;
+            while (j < rows.size() && j - i < BulkImporter::ROWS_PER_INSERT &&
+                   rows[j].section == rows[i].section) ++j;
+            writeGroup(&rows[i], j - i);
+            i = j;
+        }
+    }
+
+    // Valide la transaction avec le point de reprise (même transaction : l'un ne va
+    // jamais sans l'autre) et en ouvre une nouvelle
+    bool checkpoint(const ImportCheckpoint& point, long long rowsDone) {
+        saveCheckpoint.bind(1, point.fileHash);
+        saveCheckpoint.bind(2, point.sections);
+        saveCheckpoint.bind(3, point.filename);
+        saveCheckpoint.bind(4, point.pass);
+        saveCheckpoint.bind(5, static_cast<long long>(point.offset));
+        saveCheckpoint.bind(6, rowsDone);
+        bool saved = saveCheckpoint.run();
+        saveCheckpoint.reset();
+        return saved && db.commit() && db.begin();
+    }
+};
+
+// Affiche les premiers rejets (dans l'ordre du fichier) avec leur numéro de ligne
+void reportRejections(std::vector<Rejection>& rejections, const char* data) {
+    std::sort(rejections.begin(), rejections.end(),
+              [](const Rejection& a, const Rejection& b) { return a.offset < b.offset; });
+    if (rejections.size() > static_cast<size_t>(BulkImporter::MAX_REPORTED))
+        rejections.resize(BulkImporter::MAX_REPORTED);
+
+    long long line = 1;
+    size_t    counted = 0;
+    for (const Rejection& r : rejections) {
+        line += std::count(data + counted, data + r.offset, '\n');
+        counted = r.offset;
+        std::cerr << "  ✗ ligne " << line << " : " << r.reason << "\n";
+    }
+}
+
+// Noms non résolus, regroupés : un nom inconnu = une ligne, quel que soit le nombre de notes
+void reportUnresolved(const std::map<std::string, long long>& unresolved, long long rows) {
+    if (rows == 0) return;
+    std::cerr << "  ✗ " << rows << " note(s) non importée(s), " << unresolved.size()
+              << " nom(s) non résolu(s) :\n";
+    int shown = 0;
+    for (auto& [name, count] : unresolved) {
+        if (shown++ == BulkImporter::MAX_UNRESOLVED) {
+            std::cerr << "    ... et " << unresolved.size() - BulkImporter::MAX_UNRESOLVED
+                      << " autre(s)\n";
+            break;
+        }
+        std::cerr << "    " << name << " (" << count << " ligne(s))\n";
+    }
+}
+
+// Une passe : analyse parallèle des tranches, écriture par le thread appelant dans
+// l'ordre du fichier, une transaction (avec son point de reprise) par tranche
+bool runPass(Database& db, std::string_view text, const std::vector<Chunk>& chunks,
+             const std::vector<ImportSection>& sections, NameResolver& names,
+             ImportWriter& writer, ImportCheckpoint& point, ImportStats& stats) {
+    if (!db.begin()) return false;
+
+    // Analyse en parallèle ; le thread appelant écrit (un cœur lui est laissé)
+    unsigned nThreads = std::max(1u, std::thread::hardware_concurrency());
+    unsigned nParsers = std::max(1u, std::min<unsigned>(nThreads - (nThreads > 1 ? 1 : 0),
+                                                        static_cast<unsigned>(chunks.size())));
+    stats.parsers = std::max(stats.parsers, nParsers);
+    stats.cores   = std::min(nThreads, stats.parsers + 1);
+
+    BoundedQueue<BatchPtr> queue(BulkImporter::QUEUE_BATCHES);
+    std::atomic<size_t>    next{0};
+    std::atomic<size_t>    written{0};   // tranches écrites : borne la fenêtre de réordonnancement
+    std::atomic<unsigned>  running{nParsers};
+    std::atomic<bool>      aborted{false};
+    std::vector<std::thread> parsers;
+    for (unsigned t = 0; t < nParsers; ++t) {
+        parsers.emplace_back([&]() {
+            for (size_t i = next++; i < chunks.size() && !aborted; i = next++) {
+                while (i >= written + BulkImporter::QUEUE_BATCHES && !aborted)
+                    std::this_thread::yield();
+                auto batch = std::make_unique<ParsedBatch>();
+                batch->index = i;
+                ChunkParser(text.data(), sections, names, *batch).parse(chunks[i]);
+                while (!queue.tryPush(batch) && !aborted) std::this_thread::yield();
+            }
+            --running;
+        });
+    }
+
+    // Writer : les lots arrivés en avance attendent leur tour dans pending
+    bool ok = true;
+    std::map<size_t, BatchPtr> pending;
+    BatchPtr batch;
+    for (;;) {
+        bool done = running == 0;   // lu avant tryPop : plus aucun lot ne peut arriver ensuite
+        if (queue.tryPop(batch)) {
+            size_t index = batch->index;
+            pending[index] = std::move(batch);
+            for (auto it = pending.find(written); ok && it != pending.end();
+                 it = pending.find(written)) {
+                long long before = stats.imported;
+                writer.write(*it->second);
+                point.offset = chunks[it->first].end;
+                if (!writer.checkpoint(point, stats.imported - before)) {
+                    ok = false;
+                    aborted = true;   // les lots restants sont vidés sans être écrits
+                }
+                pending.erase(it);
+                ++written;
+            }
+        } else if (done) {
+            break;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    for (auto& t : parsers) t.join();
+
+    if (!ok || !db.commit()) {
+        db.rollback();
+        std::cerr << "✗ Échec de la transaction, tranche en cours annulée.\n"
+                  << "  Relancez l'import du même fichier pour reprendre au dernier point validé.\n";
+        return false;
+    }
+    return true;
+}
+
+// Empreinte FNV-1a 64 bits du contenu, calculée par blocs de 4 Mo en parallèle
+// puis combinée : identifie le fichier pour la reprise, quel que soit son nom
+std::string contentHash(std::string_view text) {
+    constexpr size_t BLOCK = 4 << 20;
+    auto fnv = [](const unsigned char* p, size_t n, uint64_t h) {
+        for (size_t i = 0; i < n; ++i) { h ^= p[i]; h *= 0x100000001b3ULL; }
+        return h;
+    };
+    const uint64_t basis = 0xcbf29ce484222325ULL;
+    size_t nBlocks = (text.size() + BLOCK - 1) / BLOCK;
+    std::vector<uint64_t> hashes(nBlocks);
+
+    unsigned nThreads = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(),
+                                                        static_cast<unsigned>(nBlocks)));
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < nThreads; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < nBlocks; i = next++) {
+                size_t begin = i * BLOCK;
+                hashes[i] = fnv(reinterpret_cast<const unsigned char*>(text.data()) + begin,
+                                std::min(BLOCK, text.size() - begin), basis);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    uint64_t size = text.size();
+    uint64_t h = fnv(reinterpret_cast<const unsigned char*>(&size), sizeof(size), basis);
+    h = fnv(reinterpret_cast<const unsigned char*>(hashes.data()), hashes.size() * sizeof(uint64_t), h);
+
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(h));
+    return hex;
+}
+
+
+// ─── Synchronisation : le fichier comme état cible ─────────────────────────
+
+// Analyse parallèle sans écriture : un lot par tranche, dans l'ordre du fichier
+std::vector<ParsedBatch> parseAll(std::string_view text, const std::vector<Chunk>& chunks,
+                                  const std::vector<ImportSection>& sections,
+                                  NameResolver& names, ImportStats& stats) {
+    std::vector<ParsedBatch> batches(chunks.size());
+    unsigned nThreads = std::max(1u, std::min<unsigned>(std::thread::hardware_concurrency(),
+                                                        static_cast<unsigned>(chunks.size())));
+    stats.parsers = std::max(stats.parsers, nThreads);
+    stats.cores   = std::max(1u, std::thread::hardware_concurrency());
+
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> parsers;
+    for (unsigned t = 0; t < nThreads; ++t) {
+        parsers.emplace_back([&]() {
+            for (size_t i = next++; i < chunks.size(); i = next++)
+                ChunkParser(text.data(), sections, names, batches[i]).parse(chunks[i]);
+        });
+    }
+    for (auto& t : parsers) t.join();
+    return batches;
+}
+
+// Ce qui distingue une table : clé de tri, requêtes, comparaison et liaison des valeurs.
+// insert et update partagent leurs paramètres (?1 = ID de la ligne, ?2... = valeurs).
+struct SyncSpec {
+    const char* select;   // lignes de la table triées sur la clé (ID en colonne 0)
+    const char* insert;
+    const char* update;
+    const char* remove;
+    const char* dependents;   // 1 si supprimer ?1 effacerait en cascade des notes ou résultats
+    int  (*compare)(const ParsedRow& row, const Statement& cur);   // clés fichier / table
+    bool (*same)(const ParsedRow& row, const Statement& cur);      // valeurs identiques
+    void (*bind)(Statement& stmt, const ParsedRow& row);
+    bool (*before)(const ParsedRow& a, const ParsedRow& b);        // tri du fichier
+};
+
+int compareIds(long long a, long long b) { return a < b ? -1 : a > b ? 1 : 0; }
+
+bool sameText(const ParsedRow& row, int i, const Statement& cur, int col) {
+    bool null = (row.nulls & (1u << i)) != 0;
+    if (null || cur.isNull(col)) return null && cur.isNull(col);
+    return row.text[i] == cur.getView(col);
+}
+
+bool byId(const ParsedRow& a, const ParsedRow& b) { return a.ids[0] < b.ids[0]; }
+
+const SyncSpec STUDENTS_SYNC = {
+    "SELECT id, name, email, birthdate FROM students ORDER BY id",
+    "INSERT INTO students (id, name, email, birthdate) VALUES (?1, ?2, ?3, ?4)",
+    "UPDATE students SET name = ?2, email = ?3, birthdate = ?4 WHERE id = ?1",
+    "DELETE FROM students WHERE id = ?1",
+    "SELECT EXISTS (SELECT 1 FROM grades WHERE student_id = ?1) "
+    "OR EXISTS (SELECT 1 FROM results WHERE student_id = ?1)",
+    [](const ParsedRow& r, const Statement& c) { return compareIds(r.ids[0], c.getInt(0)); },
+    [](const ParsedRow& r, const Statement& c) {
+        return sameText(r, 0, c, 1) && sameText(r, 1, c, 2) && sameText(r, 2, c, 3);
+    },
+    [](Statement& st, const ParsedRow& r) {
+        st.bind(1, r.ids[0]);
+        for (int i = 0; i < 3; ++i) bindText(st, i + 2, r, i);
+    },
+    byId};
+
+const SyncSpec COURSES_SYNC = {
+    "SELECT id, name, description, credits FROM courses ORDER BY id",
+    "INSERT INTO courses (id, name, description, credits) VALUES (?1, ?2, ?3, ?4)",
+    "UPDATE courses SET name = ?2, description = ?3, credits = ?4 WHERE id = ?1",
+    "DELETE FROM courses WHERE id = ?1",
+    "SELECT EXISTS (SELECT 1 FROM grades WHERE course_id = ?1)",
+    [](const ParsedRow& r, const Statement& c) { return compareIds(r.ids[0], c.getInt(0)); },
+    [](const ParsedRow& r, const Statement& c) {
+        return sameText(r, 0, c, 1) && sameText(r, 1, c, 2) &&
+               !c.isNull(3) && r.credits == c.getInt(3);
+    },
+    [](Statement& st, const ParsedRow& r) {
+        st.bind(1, r.ids[0]);
+        bindText(st, 2, r, 0);
+        bindText(st, 3, r, 1);
+        st.bind(4, r.credits);
+    },
+    byId};
+
+// Format d'export : clé = ID de la note, date comprise
+const SyncSpec EXPORTED_GRADES_SYNC = {
+    "SELECT id, student_id, course_id, grade, date_recorded FROM grades ORDER BY id",
+    "INSERT INTO grades (id, student_id, course_id, grade, date_recorded) VALUES (?1, ?2, ?3, ?4, ?5)",
+    "UPDATE grades SET student_id = ?2, course_id = ?3, grade = ?4, date_recorded = ?5 WHERE id = ?1",
+    "DELETE FROM grades WHERE id = ?1",
+    nullptr,
+    [](const ParsedRow& r, const Statement& c) { return compareIds(r.ids[2], c.getInt(0)); },
+    [](const ParsedRow& r, const Statement& c) {
+        return r.ids[0] == c.getInt(1) && r.ids[1] == c.getInt(2) &&
+               r.grade == c.getDouble(3) &&
+               ((r.nulls & 1u) ? c.isNull(4) : !c.isNull(4) && r.day == c.getInt(4));
+    },
+    [](Statement& st, const ParsedRow& r) {
+        st.bind(1, r.ids[2]);
+        st.bind(2, r.ids[0]);
+        st.bind(3, r.ids[1]);
+        st.bind(4, r.grade);
+        bindDay(st, 5, r);
+    },
+    [](const ParsedRow& a, const ParsedRow& b) { return a.ids[2] < b.ids[2]; }};
+
+// Format student_id|course_id|note : clé = (étudiant, cours), une note par couple ;
+// les notes en double dans la table sont supprimées. ?1 = ID de la note en table.
+const SyncSpec GRADES_SYNC = {
+    "SELECT id, student_id, course_id, grade FROM grades ORDER BY student_id, course_id, id",
+    "INSERT INTO grades (student_id, course_id, grade) VALUES (?2, ?3, ?4)",
+    "UPDATE grades SET grade = ?4 WHERE id = ?1",
+    "DELETE FROM grades WHERE id = ?1",
+    nullptr,
+    [](const ParsedRow& r, const Statement& c) {
+        int cmp = compareIds(r.ids[0], c.getInt(1));
+        return cmp != 0 ? cmp : compareIds(r.ids[1], c.getInt(2));
+    },
+    [](const ParsedRow& r, const Statement& c) { return r.grade == c.getDouble(3); },
+    [](Statement& st, const ParsedRow& r) {
+        st.bind(2, r.ids[0]);
+        st.bind(3, r.ids[1]);
+        st.bind(4, r.grade);
+    },
+    [](const ParsedRow& a, const ParsedRow& b) {
+        return a.ids[0] != b.ids[0] ? a.ids[0] < b.ids[0] : a.ids[1] < b.ids[1];
+    }};
+
+// Différence à appliquer : ligne du fichier (insertion, modification) et/ou ID en table
+struct SyncAction {
+    const ParsedRow* row;
+    long long        id;
+};
+
+// Trie les lignes du fichier, les fusionne avec la table parcourue dans le même ordre,
+// puis n'écrit que les différences : suppressions, modifications, insertions (dans cet
+// ordre, pour qu'une valeur unique puisse passer d'une ligne à une autre)
+class SectionSync {
+private:
+    Database&               db;
+    const SyncSpec&         spec;
+    ImportStats&            stats;
+    std::vector<Rejection>& rejections;
+
+    std::vector<SyncAction> inserts, updates, removals;
+
+public:
+    SectionSync(Database& db, const SyncSpec& spec, ImportStats& stats,
+                std::vector<Rejection>& rejections)
+        : db(db), spec(spec), stats(stats), rejections(rejections) {}
+
+    // rows triées ; faux si une requête ne peut être préparée
+    bool diff(std::vector<ParsedRow>& rows) {
+        Statement cur(db, spec.select);
+        if (!cur.isValid()) return false;
+        size_t i = 0;
+        bool   has = cur.step();
+        while (i < rows.size() || has) {
+            int cmp = !has ? -1 : i == rows.size() ? 1 : spec.compare(rows[i], cur);
+            if (cmp < 0) {
+                inserts.push_back({&rows[i++], 0});
+            } else if (cmp > 0) {
+                removals.push_back({nullptr, cur.getInt(0)});
+                has = cur.step();
+            } else {
+                if (spec.same(rows[i], cur)) ++stats.ignored;
+                else                         updates.push_back({&rows[i], cur.getInt(0)});
+                ++i;
+                has = cur.step();
+            }
+        }
+        return cur.ok();
+    }
+
+    // keepRemovals : section incomplète (lignes rejetées), rien n'est supprimé.
+    // keepDependents : notes non synchronisées, les lignes dont la suppression effacerait
+    // en cascade des notes ou des résultats sont conservées (comptées dans stats.kept).
+    bool apply(bool keepRemovals, bool keepDependents) {
+        Statement insert(db, spec.insert), update(db, spec.update), remove(db, spec.remove);
+        if (!insert.isValid() || !update.isValid() || !remove.isValid()) return false;
+
+        if (keepRemovals && !removals.empty()) {
+            std::cerr << "  ⚠ " << removals.size() << " suppression(s) non appliquée(s) : "
+                      << "section incomplète (lignes rejetées)\n";
+            removals.clear();
+        }
+        if (keepDependents && spec.dependents && !removals.empty()) {
+            Statement dependents(db, spec.dependents);
+            if (!dependents.isValid()) return false;
+            auto linked = [&](const SyncAction& a) {
+                dependents.reset();
+                dependents.bind(1, a.id);
+                return dependents.step() && dependents.getInt(0) != 0;
+            };
+            auto kept = std::remove_if(removals.begin(), removals.end(), linked);
+            long long count = removals.end() - kept;
+            if (!dependents.ok()) return false;
+            removals.erase(kept, removals.end());
+            if (count > 0) {
+                stats.kept += count;
+                std::cerr << "  ⚠ " << count << " suppression(s) non appliquée(s) : lignes liées à des "
+                          << "notes ou résultats, absents du fichier (section NOTES requise)\n";
+            }
+        }
+        for (const SyncAction& a : removals) {
+            remove.bind(1, a.id);
+            if (!remove.run()) return false;
+            stats.deleted += remove.changes();   // 0 si déjà supprimée en cascade
+            remove.reset();
+        }
+        auto write = [&](Statement& stmt, const SyncAction& a, long long& counter) {
+            spec.bind(stmt, *a.row);
+            if (a.id != 0) stmt.bind(1, a.id);
+            if (stmt.tryRun()) {
+                ++counter;
+            } else {
+                ++stats.rejected;
+                rejections.push_back({a.row->offset, stmt.errorMessage()});
+            }
+            stmt.reset();
+        };
+        for (const SyncAction& a : updates) write(update, a, stats.updated);
+        for (const SyncAction& a : inserts) write(insert, a, stats.imported);
+        return true;
+    }
+};
+
+} // namespace
+
+// ─── BulkImporter ──────────────────────────────────────────────────────────
+
+BulkImporter::BulkImporter(Database& db, std::vector<ImportSection> accepted)
+    : db(db), accepted(std::move(accepted)) {}
+
+bool BulkImporter::importFile(const std::string& filename, ImportStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    stats = ImportStats{};
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "✗ Fichier introuvable : " << filename << "\n";
+        return false;
+    }
+
+    ImportWriter writer(db, stats);
+    if (!writer.isValid()) return false;
+    NameResolver names(db.getPath());
+
+    std::string_view text(file.data() ? file.data() : "", file.size());
+    std::vector<SectionMark> marks = findSections(text);
+
+    // Passe 1 : étudiants et cours ; passe 2 : notes, résolues sur la base à jour
+    std::vector<std::vector<ImportSection>> passes;
+    bool grades = std::find(accepted.begin(), accepted.end(), ImportSection::GRADES) != accepted.end();
+    if (grades && accepted.size() > 1) {
+        std::vector<ImportSection> first;
+        for (ImportSection s : accepted)
+            if (s != ImportSection::GRADES) first.push_back(s);
+        passes = {first, {ImportSection::GRADES}};
+    } else {
+        passes = {accepted};
+    }
+
+    // Point de reprise d'un import interrompu du même contenu
+    ImportCheckpoint point;
+    point.fileHash = contentHash(text);
+    point.filename = filename;
+    for (ImportSection s : accepted)
+        point.sections += std::string(point.sections.empty() ? "" : ",") +
+                          (s == ImportSection::STUDENTS ? "students" :
+                           s == ImportSection::COURSES  ? "courses"  : "grades");
+    ImportCheckpoint resume = point;
+    if (loadCheckpoint(resume) && resume.offset <= text.size()) {
+        stats.resumedPass   = resume.pass;
+        stats.resumedOffset = static_cast<long long>(resume.offset);
+    } else {
+        resume.pass   = 0;
+        resume.offset = 0;
+    }
+
+    for (int pass = resume.pass; pass < static_cast<int>(passes.size()); ++pass) {
+        const auto& sections = passes[pass];
+        point.pass = pass;
+
+        size_t from = pass == resume.pass ? resume.offset : 0;
+        std::vector<Chunk> work = chunksFor(text, marks, sections, from);
+        if (!runPass(db, text, work, sections, names, writer, point, stats)) return false;
+    }
+
+    // Import terminé : le point de reprise n'a plus lieu d'être
+    Statement done(db, "DELETE FROM import_checkpoints WHERE file_hash = ?1 AND sections = ?2");
+    done.bind(1, point.fileHash);
+    done.bind(2, point.sections);
+    done.run();
+
+    reportRejections(writer.rejections, text.data());
+    reportUnresolved(writer.unresolved, stats.unresolved);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats.seconds = elapsed.count();
+    return true;
+}
+
+bool BulkImporter::loadCheckpoint(ImportCheckpoint& point) {
+    Statement stmt(db, "SELECT pass, byte_offset, rows_done, " + timeSql("updated_at") +
+                       " FROM import_checkpoints WHERE file_hash = ?1 AND sections = ?2");
+    stmt.bind(1, point.fileHash);
+    stmt.bind(2, point.sections);
+    if (!stmt.step()) return false;
+    point.pass   = static_cast<int>(stmt.getInt(0));
+    point.offset = static_cast<size_t>(stmt.getInt(1));
+    std::cout << "  Reprise d'un import interrompu : passe " << point.pass + 1 << ", octet "
+              << point.offset << " (" << stmt.getInt(2) << " ligne(s) déjà importée(s), "
+              << stmt.getText(3) << ")\n";
+    return true;
+}
+
+// ─── Synchronisation ───────────────────────────────────────────────────────
+
+bool BulkImporter::syncFile(const std::string& filename, ImportStats& stats) {
+    auto start = std::chrono::steady_clock::now();
+    stats = ImportStats{};
+
+    MappedFile file(filename);
+    if (!file.isOpen()) {
+        std::cerr << "✗ Fichier introuvable : " << filename << "\n";
+        return false;
+    }
+    std::string_view text(file.data() ? file.data() : "", file.size());
+    std::vector<SectionMark> marks = findSections(text);
+    NameResolver names(db.getPath());
+
+    std::vector<Rejection>           rejections;
+    std::map<std::string, long long> unresolved;
+
+    // Une table n'est synchronisée que si sa section figure dans le fichier
+    auto synced = [&](ImportSection section) {
+        return std::find(accepted.begin(), accepted.end(), section) != accepted.end() &&
+               std::any_of(marks.begin(), marks.end(), [&](const SectionMark& m) { return m.section == section; });
+    };
+    // Sans section NOTES, supprimer un étudiant ou un cours effacerait ses notes (cascade)
+    bool gradesSynced = synced(ImportSection::GRADES);
+
+    if (!db.begin()) return false;
+    for (ImportSection section : {ImportSection::STUDENTS, ImportSection::COURSES, ImportSection::GRADES}) {
+        if (!synced(section)) continue;
+
+        // Noms résolus sur l'état en cours de synchronisation (étudiants et cours déjà appliqués)
+        if (section == ImportSection::GRADES) names.preload(db);
+
+        std::vector<ImportSection> only = {section};
+        std::vector<ParsedBatch> batches = parseAll(text, chunksFor(text, marks, only, 0), only, names, stats);
+
+        long long rejectedBefore = stats.rejected;
+        std::vector<ParsedRow> rows;
+        for (ParsedBatch& batch : batches) {
+            stats.lines      += batch.lines;
+            stats.rejected   += batch.rejected;
+            stats.unresolved += batch.unresolvedRows;
+            rejections.insert(rejections.end(), batch.rejections.begin(), batch.rejections.end());
+            for (auto& [name, count] : batch.unresolved) unresolved[name] += count;
+            rows.insert(rows.end(), batch.rows.begin(), batch.rows.end());
+            std::vector<ParsedRow>().swap(batch.rows);
+        }
+
+        // Notes : un seul format par section, celui de la première ligne
+        bool byName = !rows.empty() && rows.front().byName;
+        const SyncSpec* spec = section == ImportSection::STUDENTS ? &STUDENTS_SYNC
+                             : section == ImportSection::COURSES  ? &COURSES_SYNC
+                             : byName ? &EXPORTED_GRADES_SYNC : &GRADES_SYNC;
+        auto mixed = std::remove_if(rows.begin(), rows.end(), [&](const ParsedRow& row) {
+            if (section != ImportSection::GRADES || row.byName == byName) return false;
+            if (stats.rejected++ - rejectedBefore < MAX_REPORTED)
+                rejections.push_back({row.offset, "format de note différent du reste de la section"});
+            return true;
+        });
+        rows.erase(mixed, rows.end());
+
+        // Tri stable : en cas de clé en double, la première ligne du fichier est retenue
+        std::stable_sort(rows.begin(), rows.end(), spec->before);
+        auto duplicate = std::unique(rows.begin(), rows.end(), [&](const ParsedRow& a, const ParsedRow& b) {
+            if (spec->before(a, b)) return false;
+            if (stats.rejected++ - rejectedBefore < MAX_REPORTED)
+                rejections.push_back({b.offset, "clé en double dans le fichier"});
+            return true;
+        });
+        rows.erase(duplicate, rows.end());
+
+        SectionSync sync(db, *spec, stats, rejections);
+        if (!sync.diff(rows) || !sync.apply(stats.rejected > rejectedBefore, !gradesSynced)) {
+            db.rollback();
+            std::cerr << "✗ Échec de la synchronisation, aucune modification appliquée.\n";
+            return false;
+        }
+    }
+    if (!db.commit()) {
+        db.rollback();
+        return false;
+    }
+
+    reportRejections(rejections, text.data());
+    reportUnresolved(unresolved, stats.unresolved);
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    stats.seconds = elapsed.count();
+    return true;
+}
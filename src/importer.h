@@ -0,0 +1,123 @@
+#ifndef IMPORTER_H
+#define IMPORTER_H
+
+#include "database.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Fichier projeté en mémoire (mmap / MapViewOfFile) : lecture sans copie ni getline
+class MappedFile {
+private:
+    const char* bytes;
+    size_t      length;
+    bool        opened;
+#ifdef _WIN32
+    void*       fileHandle;
+    void*       mapping;
+#endif
+
+public:
+    explicit MappedFile(const std::string& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool        isOpen() const;   // vrai aussi pour un fichier vide
+    const char* data() const;
+    size_t      size() const;
+};
+
+// Parcourt un tampon délimiteur par délimiteur ('|' et '\n'), 16 octets à la fois en SSE2
+class DelimiterScanner {
+private:
+    const char* block;   // début du bloc courant de 16 octets
+    const char* end;
+    uint32_t    mask;    // bits restants : positions des délimiteurs dans le bloc
+
+    void load();
+
+public:
+    DelimiterScanner(const char* begin, const char* end);
+
+    // Position du prochain délimiteur, end s'il n'y en a plus
+    const char* next();
+};
+
+enum class ImportSection { NONE, STUDENTS, COURSES, GRADES };
+
+struct ImportStats {
+    long long lines    = 0;
+    long long imported = 0;
+    long long ignored  = 0;   // déjà présentes (INSERT OR IGNORE), inchangées (synchronisation)
+    long long updated  = 0;   // synchronisation : lignes modifiées
+    long long deleted  = 0;   // synchronisation : lignes absentes du fichier, supprimées
+    long long kept     = 0;   // synchronisation : absentes du fichier mais conservées (notes liées)
+    long long rejected = 0;   // champs invalides ou contrainte violée
+    long long unresolved = 0; // dont notes à l'étudiant / au cours introuvable par son nom
+    double    seconds  = 0;
+    unsigned  parsers  = 0;   // threads d'analyse (+ le thread writer)
+    unsigned  cores    = 0;   // cœurs effectivement disponibles pour ces threads
+    int       resumedPass   = -1;   // reprise d'un import interrompu : passe et octet
+    long long resumedOffset = -1;
+};
+
+// Point de reprise, enregistré dans la même transaction que chaque tranche écrite
+struct ImportCheckpoint {
+    std::string fileHash;   // empreinte du contenu (FNV-1a 64 bits)
+    std::string sections;   // "grades", "students,courses,grades"...
+    std::string filename;
+    int         pass   = 0;
+    size_t      offset = 0;   // tout ce qui précède est écrit
+};
+
+// Import du format texte pipe-séparé (celui de l'export) :
+// "--- ETUDIANTS ---"  id|nom|email|naissance
+// "--- COURS ---"      id|nom|description|credits
+// "--- NOTES ---"      student_id|course_id|note
+//                  ou id|étudiant|cours|note|date (format d'export : noms ou email)
+// Les lignes vides, "=..." et "#..." sont ignorées, ainsi que la ligne d'en-tête de
+// chaque section ; "NULL" donne une valeur NULL.
+//
+// Le fichier est découpé en tranches alignées sur les fins de ligne, analysées et
+// validées en parallèle ; les lots obtenus passent par une file bornée sans verrou
+// vers un seul writer (le thread appelant, propriétaire de la connexion).
+// Les lots sont écrits dans l'ordre du fichier, une transaction par tranche, avec le
+// point de reprise (import_checkpoints) : un import interrompu reprend après la dernière
+// tranche validée. Les notes sont importées dans une seconde passe, une fois étudiants
+// et cours écrits, pour que leurs noms puissent être résolus.
+class BulkImporter {
+public:
+    static constexpr size_t    CHUNK_BYTES   = 4 << 20;   // taille visée d'une tranche (= transaction)
+    static constexpr size_t    QUEUE_BATCHES = 16;        // lots analysés d'avance (fenêtre de réordonnancement)
+    static constexpr size_t    ROWS_PER_INSERT = 64;      // étudiants / cours par requête INSERT
+    static constexpr int       MAX_FIELDS    = 8;
+    static constexpr int       MAX_REPORTED  = 5;         // rejets détaillés à l'écran
+    static constexpr int       MAX_UNRESOLVED = 20;       // noms non résolus listés
+
+private:
+    Database&                  db;
+    std::vector<ImportSection> accepted;
+
+    bool loadCheckpoint(ImportCheckpoint& point);
+
+public:
+    // accepted : sections importées, les autres sont lues et ignorées
+    BulkImporter(Database& db, std::vector<ImportSection> accepted);
+
+    // Retourne false si le fichier est illisible ou si une transaction échoue
+    bool importFile(const std::string& filename, ImportStats& stats);
+
+    // Synchronisation : chaque section présente dans le fichier est l'état voulu de sa
+    // table. Fichier et table sont parcourus triés sur la clé (ID ; étudiant + cours pour
+    // les notes sans ID) et seules les différences sont écrites, en une transaction.
+    // Une section avec des lignes rejetées ne supprime rien. Sans section NOTES dans le
+    // fichier, un étudiant ou un cours absent qui a des notes (ou des résultats) est
+    // conservé : sa suppression effacerait en cascade des données non synchronisées.
+    bool syncFile(const std::string& filename, ImportStats& stats);
+};
+
+#endif // IMPORTER_H
@@ -3,6 +3,7 @@
 #include <memory>
 
 #include "database.h"
+#include "records.h"
 #include "user.h"
 #include "admin.h"
 #include "prof.h"
@@ -22,17 +23,14 @@ std::unique_ptr<User> authenticate(Database& db) {
     std::cout << "Login    : "; std::getline(std::cin, username);
     std::cout << "Password : "; std::getline(std::cin, password);
 
-    std::string sql = "SELECT id, username, role FROM users WHERE username='"
-        + db.escape(username) + "' AND password='" + db.escape(password) + "'";
-
-    auto rows = db.query(sql);
-    if (rows.empty()) {
+    auto account = UserRepository(db).authenticate(username, password);
+    if (!account) {
         std::cout << "\n✗ Identifiants incorrects.\n";
         return nullptr;
     }
 
-    int uid = std::stoi(rows[0]["id"]);
-    std::string role = rows[0]["role"];
+    int uid = static_cast<int>(account->id);
+    const std::string& role = account->role;
     std::cout << "\n✓ Connecte en tant que : " << username << " [" << role << "]\n";
 
     if (role == "admin")
@@ -42,10 +40,8 @@ std::unique_ptr<User> authenticate(Database& db) {
         return std::make_unique<Prof>(uid, username, password, db);
 
     if (role == "student") {
-        auto sRows = db.query(
-            "SELECT id FROM students WHERE email=("
-            "SELECT email FROM users WHERE id=" + std::to_string(uid) + ")");
-        int studentId = sRows.empty() ? -1 : std::stoi(sRows[0]["id"]);
+        auto record = StudentRepository(db).ofUser(uid);
+        int studentId = record ? static_cast<int>(record->id) : -1;
         return std::make_unique<Student>(uid, username, password, db, studentId);
     }
 
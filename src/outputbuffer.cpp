@@ -0,0 +1,118 @@
+#include "outputbuffer.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#ifdef _WIN32
+#include <io.h>
+#define write _write
+#define fileno _fileno
+#else
+#include <unistd.h>
+#endif
+
+// Décode le point de code UTF-8 commençant en text[i] et avance i
+static char32_t nextCodePoint(std::string_view text, size_t& i) {
+    auto byte = [&](size_t k) { return static_cast<unsigned char>(text[k]); };
+    unsigned char c = byte(i);
+    int extra = c < 0x80 ? 0 : c < 0xE0 ? 1 : c < 0xF0 ? 2 : 3;
+    char32_t cp = extra == 0 ? c : c & (0x3F >> extra);
+    ++i;
+    for (int k = 0; k < extra && i < text.size() && (byte(i) & 0xC0) == 0x80; ++k, ++i)
+        cp = (cp << 6) | (byte(i) & 0x3F);
+    return cp;
+}
+
+static int codePointWidth(char32_t cp) {
+    if (cp >= 0x0300 && cp <= 0x036F) return 0;                  // diacritiques combinants
+    if ((cp >= 0x1100 && cp <= 0x115F) || (cp >= 0x2E80 && cp <= 0xA4CF) ||
+        (cp >= 0xAC00 && cp <= 0xD7A3) || (cp >= 0xF900 && cp <= 0xFAFF) ||
+        (cp >= 0xFE30 && cp <= 0xFE4F) || (cp >= 0xFF00 && cp <= 0xFF60) ||
+        (cp >= 0xFFE0 && cp <= 0xFFE6) || (cp >= 0x1F300 && cp <= 0x1FAFF) ||
+        (cp >= 0x20000 && cp <= 0x3FFFD))
+        return 2;                                                   // pleine chasse
+    return 1;
+}
+
+int displayWidth(std::string_view text) {
+    int width = 0;
+    size_t i = 0;
+    while (i < text.size()) {
+        if (static_cast<unsigned char>(text[i]) < 0x80) { ++width; ++i; continue; }
+        width += codePointWidth(nextCodePoint(text, i));
+    }
+    return width;
+}
+
+// ─── OutputBuffer ──────────────────────────────────────────────────────────
+
+OutputBuffer::OutputBuffer(FILE* out, size_t capacity)
+    : buffer(new char[capacity]), used(0), capacity(capacity), fd(fileno(out)), failed(false), written(0) {
+    // Ce qui a déjà été écrit via std::cout doit sortir avant le tableau
+    std::cout.flush();
+    std::fflush(out);
+}
+
+OutputBuffer::~OutputBuffer() { flush(); }
+
+void OutputBuffer::append(std::string_view text) {
+    if (text.size() > capacity) {
+        flush();
+        std::string_view rest = text;
+        while (!rest.empty()) {
+            size_t n = std::min(rest.size(), capacity);
+            append(rest.substr(0, n));
+            rest.remove_prefix(n);
+        }
+        return;
+    }
+    reserve(text.size());
+    std::memcpy(buffer.get() + used, text.data(), text.size());
+    used += text.size();
+}
+
+void OutputBuffer::append(char c, size_t count) {
+    while (count > 0) {
+        reserve(1);
+        size_t n = std::min(count, capacity - used);
+        std::memset(buffer.get() + used, c, n);
+        used += n;
+        count -= n;
+    }
+}
+
+void OutputBuffer::cell(std::string_view text, int width) {
+    // Largeur calculée pendant la copie : un seul passage sur le texte
+    int used_width = 0;
+    bool ascii = true;
+    if (text.size() + static_cast<size_t>(width) + 1 <= capacity) {
+        reserve(text.size() + static_cast<size_t>(width) + 1);
+        char* dst = buffer.get() + used;
+        for (char c : text) {
+            *dst++ = c;
+            ascii &= static_cast<unsigned char>(c) < 0x80;
+        }
+        used += text.size();
+        used_width = ascii ? static_cast<int>(text.size()) : displayWidth(text);
+    } else {
+        append(text);
+        used_width = displayWidth(text);
+    }
+    // Texte plus large que la colonne : on garde au moins un espace de séparation
+    append(' ', used_width < width ? static_cast<size_t>(width - used_width) : 1);
+}
+
+void OutputBuffer::flush() {
+    size_t done = 0;
+    while (done < used) {
+        auto n = write(fd, buffer.get() + done, static_cast<unsigned>(used - done));
+        if (n <= 0) { failed = true; break; }
+        done += static_cast<size_t>(n);
+    }
+    written += done;
+    used = 0;
+}
+
+bool OutputBuffer::good() const { return !failed; }
+
+unsigned long long OutputBuffer::bytesWritten() const { return written + used; }
@@ -0,0 +1,40 @@
+#ifndef OUTPUTBUFFER_H
+#define OUTPUTBUFFER_H
+
+#include <cstdio>
+#include <memory>
+#include <string_view>
+
+// Largeur affichée d'un texte UTF-8 (accents = 1 colonne, diacritiques combinants = 0,
+// caractères asiatiques pleine chasse = 2), contrairement à std::setw qui compte les octets
+int displayWidth(std::string_view text);
+
+// Tampon de sortie : le texte est formaté en mémoire puis écrit par gros blocs,
+// un seul appel système par bloc
+class OutputBuffer {
+private:
+    std::unique_ptr<char[]> buffer;
+    size_t                  used;
+    size_t                  capacity;
+    int                     fd;
+    bool                    failed;
+    unsigned long long      written;
+
+    void reserve(size_t bytes) { if (used + bytes > capacity) flush(); }
+
+public:
+    explicit OutputBuffer(FILE* out = stdout, size_t capacity = 1 << 16);
+    ~OutputBuffer();
+
+    OutputBuffer(const OutputBuffer&) = delete;
+    OutputBuffer& operator=(const OutputBuffer&) = delete;
+
+    void append(std::string_view text);
+    void append(char c, size_t count = 1);
+    void cell(std::string_view text, int width);   // texte aligné à gauche sur width colonnes
+    void flush();
+    bool good() const;   // false si une écriture a échoué (disque plein, ...)
+    unsigned long long bytesWritten() const;
+};
+
+#endif // OUTPUTBUFFER_H
@@ -0,0 +1,110 @@
+#include "pager.h"
+#include <algorithm>
+#include <iostream>
+
+KeysetPager::KeysetPager(Database& db, KeysetQuery spec, int pageSize)
+    : db(db), spec(std::move(spec)), pageSize(pageSize) {
+    if (this->spec.indexedPrefix == 0 || this->spec.indexedPrefix > this->spec.keyExprs.size())
+        this->spec.indexedPrefix = this->spec.keyExprs.size();
+}
+
+static std::string tuple(const std::vector<std::string>& items, size_t from, size_t to,
+                         const std::string& suffix = "") {
+    std::string out = "(";
+    for (size_t i = from; i < to; ++i) {
+        if (i > from) out += ", ";
+        out += items[i] + suffix;
+    }
+    return out + ")";
+}
+
+static std::string placeholders(size_t n) {
+    return tuple(std::vector<std::string>(n, "?"), 0, n);
+}
+
+ResultSet KeysetPager::fetch(const std::vector<std::string>* boundary, bool forward) {
+    const auto& keys = spec.keyExprs;
+    size_t lead = spec.indexedPrefix;
+    std::string cmp   = forward ? " > " : " < ";
+    std::string cmpEq = forward ? " >= " : " <= ";
+
+    std::vector<std::string> conditions;
+    if (!spec.where.empty()) conditions.push_back("(" + spec.where + ")");
+
+    // La partie indexée sert de borne de recherche ; le reste départage les ex æquo
+    std::vector<std::string> params;
+    if (boundary) {
+        std::string head = tuple(keys, 0, lead);
+        if (lead == keys.size()) {
+            conditions.push_back(head + cmp + placeholders(lead));
+            params.assign(boundary->begin(), boundary->end());
+        } else {
+            conditions.push_back(head + cmpEq + placeholders(lead) + " AND (" + head + cmp
+                                 + placeholders(lead) + " OR " + tuple(keys, lead, keys.size())
+                                 + cmp + placeholders(keys.size() - lead) + ")");
+            params.assign(boundary->begin(), boundary->begin() + lead);
+            params.insert(params.end(), boundary->begin(), boundary->end());
+        }
+    }
+
+    std::string sql = spec.select;
+    for (size_t i = 0; i < conditions.size(); ++i)
+        sql += (i == 0 ? " WHERE " : " AND ") + conditions[i];
+    std::string order = tuple(keys, 0, keys.size(), forward ? " ASC" : " DESC");
+    sql += " ORDER BY " + order.substr(1, order.size() - 2)
+         + " LIMIT " + std::to_string(pageSize + 1);
+
+    return db.query(sql, params);
+}
+
+std::vector<std::string> KeysetPager::keyOf(const Row& row) const {
+    std::vector<std::string> key;
+    for (auto& col : spec.keyCols) key.push_back(row.at(col));
+    return key;
+}
+
+bool KeysetPager::browse(const std::function<void(const ResultSet&)>& render) {
+    ResultSet page = fetch(nullptr, true);
+    if (page.empty()) return false;
+
+    bool hasPrev = false;
+    bool hasNext = static_cast<int>(page.size()) > pageSize;
+    if (hasNext) page.pop_back();
+
+    int pageNo = 1;
+    bool redraw = true;
+    while (true) {
+        if (redraw) render(page);
+        if (!hasPrev && !hasNext) return true;
+        redraw = true;
+
+        std::cout << "-- Page " << pageNo << " -- ";
+        if (hasPrev) std::cout << "[p] Précédente  ";
+        if (hasNext) std::cout << "[s] Suivante  ";
+        std::cout << "[Entrée] Fermer : ";
+
+        std::string choice;
+        if (!std::getline(std::cin, choice)) return true;
+
+        if (choice == "s" && hasNext) {
+            auto key = keyOf(page.back());
+            page = fetch(&key, true);
+            hasNext = static_cast<int>(page.size()) > pageSize;
+            if (hasNext) page.pop_back();
+            hasPrev = true;
+            ++pageNo;
+        } else if (choice == "p" && hasPrev) {
+            auto key = keyOf(page.front());
+            page = fetch(&key, false);
+            hasPrev = static_cast<int>(page.size()) > pageSize;
+            if (hasPrev) page.pop_back();
+            std::reverse(page.begin(), page.end());
+            hasNext = true;
+            --pageNo;
+        } else if (choice.empty()) {
+            return true;
+        } else {
+            redraw = false;
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#ifndef PAGER_H
+#define PAGER_H
+
+#include "database.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+// Nombre de lignes affichées par page
+constexpr int PAGE_SIZE = 20;
+
+// Description d'une liste paginée par clé (keyset) : pas d'OFFSET, chaque page
+// repart de la dernière clé affichée grâce à un index.
+struct KeysetQuery {
+    std::string select;                 // "SELECT ... FROM ..." sans WHERE ni ORDER BY
+    std::string where;                  // filtre optionnel (sans le mot-clé WHERE)
+    std::vector<std::string> keyExprs;  // expressions SQL de la clé de tri, unique au total
+    std::vector<std::string> keyCols;   // colonnes du résultat correspondant à keyExprs
+    size_t indexedPrefix = 0;           // nb d'expressions en tête suivies par un index (0 = toutes)
+};
+
+class KeysetPager {
+private:
+    Database&   db;
+    KeysetQuery spec;
+    int         pageSize;
+
+    // Page après (forward) ou avant (!forward) la clé donnée ; pageSize + 1 lignes max
+    ResultSet fetch(const std::vector<std::string>* boundary, bool forward);
+    std::vector<std::string> keyOf(const Row& row) const;
+
+public:
+    KeysetPager(Database& db, KeysetQuery spec, int pageSize = PAGE_SIZE);
+
+    // Affiche la première page puis propose suivant / précédent.
+    // Retourne false si la liste est vide.
+    bool browse(const std::function<void(const ResultSet&)>& render);
+};
+
+#endif // PAGER_H
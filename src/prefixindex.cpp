@@ -0,0 +1,229 @@
+#include "prefixindex.h"
+#include <algorithm>
+#include <sstream>
+
+// Lettres U+00C0 à U+00FF (deuxième octet UTF-8 après 0xC3) sans leur accent
+static const char* const LATIN1_FOLD[64] = {
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "ss",
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", nullptr, "o", "u", "u", "u", "u", "y", "th", "y"};
+
+static bool isWordStart(std::string_view key, size_t i) {
+    if (i == 0) return true;
+    char before = key[i - 1];
+    return before == ' ' || before == '-' || before == '\'';
+}
+
+// Mots d'une saisie repliée
+static std::vector<std::string> words(const std::string& folded) {
+    std::vector<std::string> out;
+    std::string word;
+    std::istringstream in(folded);
+    while (in >> word) out.push_back(word);
+    return out;
+}
+
+PrefixIndex::PrefixIndex(Database& db, std::string table)
+    : db(db), table(std::move(table)), changes(db.subscribe()) {
+    // Abonné avant la lecture : un changement validé pendant la construction est
+    // rejoué ensuite (rejouer un changement déjà lu est sans effet)
+    builder = std::thread([this]() {
+        Database reader(this->db.getPath());
+        if (reader.connectReadOnly() && load(reader)) ready = true;
+    });
+}
+
+PrefixIndex::~PrefixIndex() {
+    stopping = true;
+    if (builder.joinable()) builder.join();
+    if (changes) db.unsubscribe(changes);
+}
+
+std::string PrefixIndex::fold(std::string_view text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        auto c = static_cast<unsigned char>(text[i]);
+        if (c < 0x80) {
+            out += static_cast<char>(c >= 'A' && c <= 'Z' ? c - 'A' + 'a' : c);
+            continue;
+        }
+        auto next = i + 1 < text.size() ? static_cast<unsigned char>(text[i + 1]) : 0;
+        if (c == 0xC3 && next >= 0x80 && next <= 0xBF && LATIN1_FOLD[next - 0x80]) {
+            out += LATIN1_FOLD[next - 0x80];
+            ++i;
+        } else if (c == 0xC5 && (next == 0x92 || next == 0x93)) {   // Œ, œ
+            out += "oe";
+            ++i;
+        } else {
+            out += static_cast<char>(c);   // autres caractères : octets inchangés
+        }
+    }
+    return out;
+}
+
+// ─── Construction ──────────────────────────────────────────────────────────
+
+std::string_view PrefixIndex::view(const Entry& e) const {
+    return std::string_view(keys.data() + e.pos, e.length);
+}
+
+// Ajoute un nom (replié) et ses débuts de mots
+void PrefixIndex::append(long long id, std::string_view name, std::vector<Entry>& target) {
+    std::string key = fold(name);
+    auto begin = static_cast<uint32_t>(keys.size());
+    auto index = static_cast<uint32_t>(records.size());
+    keys += key;
+    records.push_back({id, begin, static_cast<uint32_t>(keys.size()), true});
+    for (size_t i = 0; i < key.size(); ++i)
+        if (key[i] != ' ' && isWordStart(key, i))
+            target.push_back({begin + static_cast<uint32_t>(i),
+                              static_cast<uint32_t>(key.size() - i), index});
+}
+
+void PrefixIndex::sortEntries() {
+    std::sort(entries.begin(), entries.end(),
+              [this](const Entry& a, const Entry& b) { return view(a) < view(b); });
+}
+
+bool PrefixIndex::load(const Database& source) {
+    keys.clear();
+    records.clear();
+    entries.clear();
+    extraEntries.clear();
+    extraIds.clear();
+
+    Statement stmt(source, "SELECT id, name FROM " + table + " ORDER BY id");
+    while (stmt.step()) {
+        if (stopping) return false;
+        append(stmt.getInt(0), stmt.isNull(1) ? std::string_view() : stmt.getView(1), entries);
+    }
+    sortEntries();
+    sortedRecords = records.size();
+    return true;
+}
+
+// Refonte du complément dans l'index trié, sans relire la base
+void PrefixIndex::compact() {
+    std::vector<std::pair<long long, std::string>> live;
+    live.reserve(records.size());
+    for (const Record& r : records)
+        if (r.live) live.emplace_back(r.id, keys.substr(r.keyBegin, r.keyEnd - r.keyBegin));
+    std::sort(live.begin(), live.end());
+
+    keys.clear();
+    records.clear();
+    entries.clear();
+    extraEntries.clear();
+    extraIds.clear();
+    for (auto& [id, key] : live) append(id, key, entries);   // déjà repliées : fold() est idempotent
+    sortEntries();
+    sortedRecords = records.size();
+}
+
+// ─── Mise à jour par les changements validés ───────────────────────────────
+
+PrefixIndex::Record* PrefixIndex::find(long long id) {
+    auto extra = extraIds.find(id);
+    if (extra != extraIds.end()) return &records[extra->second];
+    auto end = records.begin() + static_cast<std::ptrdiff_t>(sortedRecords);
+    auto it  = std::lower_bound(records.begin(), end, id,
+                                [](const Record& r, long long value) { return r.id < value; });
+    return it != end && it->id == id && it->live ? &*it : nullptr;
+}
+
+void PrefixIndex::refresh() {
+    if (!changes) return;
+    if (changes->overflowed()) {
+        load(db);
+        RowChange drop;
+        while (changes->poll(drop)) {}   // déjà pris en compte par le rechargement
+        return;
+    }
+
+    RowChange change;
+    std::unique_ptr<Statement> name;   // préparée au premier changement de la table
+    while (changes->poll(change)) {
+        if (change.table != table) continue;
+        if (Record* old = find(change.rowid)) old->live = false;
+        extraIds.erase(change.rowid);
+        if (change.op == 'D') continue;
+
+        // Nom actuel (la ligne a pu changer encore, ou disparaître, depuis)
+        if (!name) name = std::make_unique<Statement>(db, "SELECT name FROM " + table + " WHERE id = ?");
+        name->bind(1, change.rowid);
+        if (name->step() && !name->isNull(0)) {
+            extraIds[change.rowid] = static_cast<uint32_t>(records.size());
+            append(change.rowid, name->getView(0), extraEntries);
+        }
+        name->reset();
+    }
+    if (extraIds.size() > MAX_OVERLAY) compact();
+}
+
+// ─── Complétion ────────────────────────────────────────────────────────────
+
+bool PrefixIndex::isReady() const { return ready; }
+
+std::vector<long long> PrefixIndex::complete(const std::string& prefix, size_t limit) {
+    std::vector<long long> ids;
+    if (!ready) return ids;
+    refresh();
+
+    std::vector<std::string> terms = words(fold(prefix));
+    if (terms.empty()) return ids;
+
+    // Le mot dont la plage de l'index est la plus étroite est parcouru, les autres
+    // filtrent les noms trouvés (à égalité, le dernier : en général le nom de famille)
+    auto less = [this](const Entry& e, const std::string& value) { return view(e) < value; };
+    auto rangeOf = [&](const std::string& term) {
+        // Fin de plage : premier mot >= "jes" pour "jer" (dernier octet incrémenté)
+        std::string upper = term;
+        while (!upper.empty() && static_cast<unsigned char>(upper.back()) == 0xFF) upper.pop_back();
+        if (!upper.empty()) upper.back() = static_cast<char>(upper.back() + 1);
+        auto first = std::lower_bound(entries.begin(), entries.end(), term, less);
+        auto last  = upper.empty() ? entries.end()
+                                   : std::lower_bound(first, entries.end(), upper, less);
+        return std::make_pair(first, last);
+    };
+    size_t leadIndex = 0;
+    auto   range     = rangeOf(terms[0]);
+    for (size_t i = 1; i < terms.size(); ++i) {
+        auto candidate = rangeOf(terms[i]);
+        if (candidate.second - candidate.first <= range.second - range.first) {
+            range     = candidate;
+            leadIndex = i;
+        }
+    }
+    std::string lead = terms[leadIndex];
+    terms.erase(terms.begin() + static_cast<std::ptrdiff_t>(leadIndex));
+
+    auto matches = [&](const Record& r) {
+        if (!r.live) return false;
+        std::string_view key(keys.data() + r.keyBegin, r.keyEnd - r.keyBegin);
+        for (const std::string& term : terms) {
+            bool found = false;
+            for (size_t i = key.find(term); i != std::string_view::npos && !found; i = key.find(term, i + 1))
+                found = isWordStart(key, i);
+            if (!found) return false;
+        }
+        return true;
+    };
+
+    // Candidats : (mot trouvé, record), de l'index trié puis du complément
+    std::vector<std::pair<std::string_view, uint32_t>> found;
+    auto take = [&](const Entry& e) {
+        bool seen = std::any_of(found.begin(), found.end(),
+                                [&](const auto& f) { return f.second == e.record; });
+        if (!seen && matches(records[e.record])) found.emplace_back(view(e), e.record);
+    };
+    for (auto it = range.first; it != range.second && found.size() < limit; ++it)
+        take(*it);
+    for (const Entry& e : extraEntries)
+        if (view(e).compare(0, lead.size(), lead) == 0) take(e);
+
+    std::sort(found.begin(), found.end());
+    for (size_t i = 0; i < found.size() && i < limit; ++i) ids.push_back(records[found[i].second].id);
+    return ids;
+}
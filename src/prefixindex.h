@@ -0,0 +1,86 @@
+#ifndef PREFIXINDEX_H
+#define PREFIXINDEX_H
+
+#include "database.h"
+#include "changefeed.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Index en mémoire des noms d'une table (students ou courses) pour l'autocomplétion.
+// Les noms repliés (minuscules, sans accents) sont rangés bout à bout dans un seul
+// tampon ; un tableau trié des débuts de mots y renvoie, si bien qu'une complétion est
+// une recherche dichotomique suivie d'un court parcours, sans accès à la base.
+//
+// Construit en arrière-plan, sur une connexion en lecture seule, dès la connexion de
+// l'utilisateur ; tenu à jour ensuite par les changements validés de la connexion
+// principale (ChangeFeed). Les noms ajoutés ou modifiés depuis la construction vont
+// dans un complément non trié, refondu dans l'index trié quand il dépasse MAX_OVERLAY.
+// Si des changements ont été perdus (file de l'abonnement pleine), l'index est rechargé.
+class PrefixIndex {
+public:
+    static constexpr size_t MAX_OVERLAY = 4096;   // noms modifiés avant refonte
+
+private:
+    struct Record {
+        long long id;
+        uint32_t  keyBegin;   // nom replié : keys[keyBegin, keyEnd)
+        uint32_t  keyEnd;
+        bool      live;       // faux une fois la ligne supprimée ou renommée
+    };
+
+    // Début d'un mot dans un nom replié
+    struct Entry {
+        uint32_t pos;
+        uint32_t length;   // jusqu'à la fin du nom
+        uint32_t record;
+    };
+
+    Database&   db;
+    std::string table;
+    std::shared_ptr<ChangeSubscription> changes;
+
+    std::string         keys;
+    std::vector<Record> records;        // [0, sortedRecords) triés par ID, puis le complément
+    std::vector<Entry>  entries;        // index trié (records triés)
+    std::vector<Entry>  extraEntries;   // complément, non trié
+    std::unordered_map<long long, uint32_t> extraIds;   // ID → record du complément
+    size_t              sortedRecords = 0;
+
+    std::thread       builder;
+    std::atomic<bool> ready{false};
+    std::atomic<bool> stopping{false};
+
+    std::string_view view(const Entry& e) const;
+    void   append(long long id, std::string_view name, std::vector<Entry>& target);
+    void   sortEntries();
+    bool   load(const Database& source);   // faux si interrompu
+    void   compact();
+    void   refresh();
+    Record* find(long long id);
+
+public:
+    // table : "students" ou "courses" (colonnes id et name)
+    PrefixIndex(Database& db, std::string table);
+    ~PrefixIndex();
+
+    PrefixIndex(const PrefixIndex&) = delete;
+    PrefixIndex& operator=(const PrefixIndex&) = delete;
+
+    // Minuscules ASCII, lettres latines accentuées ramenées à leur base ("Jérôme" → "jerome")
+    static std::string fold(std::string_view text);
+
+    // Faux tant que la construction n'est pas terminée (les appelants passent par SQL)
+    bool isReady() const;
+
+    // IDs des noms (au plus limit, par ordre alphabétique du mot trouvé) dont un mot
+    // commence par prefix ; "jer dur" trouve « Jérôme Durand »
+    std::vector<long long> complete(const std::string& prefix, size_t limit);
+};
+
+#endif // PREFIXINDEX_H
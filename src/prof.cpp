@@ -1,9 +1,18 @@
 #include "prof.h"
+#include "dates.h"
+#include "results.h"
+#include "pager.h"
+#include "search.h"
+#include "selector.h"
+#include "table.h"
+#include "filemanager.h"
+#include "gradesession.h"
+#include "records.h"
 #include <iostream>
-#include <iomanip>
 
 Prof::Prof(int id, const std::string& username, const std::string& password, Database& db)
-    : User(id, username, password, Role::PROF), db(db) {}
+    : User(id, username, password, Role::PROF), db(db),
+      studentNames(db, "students"), courseNames(db, "courses") {}
 
 void Prof::showMenu() {
     int choice = 0;
@@ -16,6 +25,10 @@ void Prof::showMenu() {
         std::cout << "  [3] Voir les notes\n";
         std::cout << "  [4] Ajouter une note\n";
         std::cout << "  [5] Modifier une note\n";
+        std::cout << "  [6] Exporter les notes\n";
+        std::cout << "  [7] Importer des notes\n";
+        std::cout << "  [8] Rechercher (étudiants, cours)\n";
+        std::cout << "  [9] Saisie groupée des notes d'un cours\n";
         std::cout << "  [0] Déconnexion\n";
         std::cout << "------------------------------\n";
         std::cout << "Choix : ";
@@ -28,112 +41,99 @@ void Prof::showMenu() {
             case 3: listGrades();   break;
             case 4: addGrade();     break;
             case 5: updateGrade();  break;
+            case 6: FileManager(db).exportData(*this); break;
+            case 7: FileManager(db).importData(*this); break;
+            case 8: FullTextSearch(db).prompt(); break;
+            case 9: enterCourseGrades(); break;
             case 0: std::cout << "Déconnexion...\n"; break;
             default: std::cout << "Option invalide.\n";
         }
     } while (choice != 0);
 }
 
+// Mêmes clés de pagination que côté Admin (idx_students_name)
+static const KeysetQuery STUDENTS_PAGE = {
+    "SELECT s.id, s.name, s.email FROM students s", "",
+    {"s.name", "s.id"}, {"name", "id"}};
+
+static const KeysetQuery GRADES_PAGE = {
+    "SELECT g.id, s.id AS sid, s.name AS student, c.name AS course, g.grade, "
+    + daySql("g.date_recorded") + " AS date_recorded "
+    "FROM students s "
+    "CROSS JOIN grades g ON g.student_id = s.id "
+    "JOIN courses  c ON g.course_id  = c.id", "",
+    {"s.name", "s.id", "c.name", "g.id"}, {"student", "sid", "course", "id"}, 2};
+
+static constexpr std::array<Column, 3> STUDENT_COLUMNS = {{
+    {"ID", "id", 5}, {"Nom", "name", 25}, {"Email", "email", 30}}};
+
+static constexpr std::array<Column, 3> COURSE_COLUMNS = {{
+    {"ID", "id", 5}, {"Cours", "name", 25}, {"Crédits", "credits", 10}}};
+
+static constexpr std::array<Column, 5> GRADE_COLUMNS = {{
+    {"ID", "id", 5}, {"Étudiant", "student", 25}, {"Cours", "course", 25},
+    {"Note", "grade", 8}, {"Date", "date_recorded", 12}}};
+
+static void printStudents(const ResultSet& rows) { printTable(STUDENT_COLUMNS, rows); }
+static void printGrades(const ResultSet& rows)   { printTable(GRADE_COLUMNS, rows); }
+
 void Prof::listStudents() {
-    auto rows = db.query("SELECT id, name, email FROM students ORDER BY name");
-    if (rows.empty()) { std::cout << "Aucun étudiant.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(25) << "Nom"
-              << std::setw(30) << "Email" << "\n";
-    std::cout << std::string(60, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(25) << row["name"]
-                  << std::setw(30) << row["email"] << "\n";
-    }
+    if (!KeysetPager(db, STUDENTS_PAGE).browse(printStudents))
+        std::cout << "Aucun étudiant.\n";
 }
 
 void Prof::listCourses() {
     auto rows = db.query("SELECT id, name, credits FROM courses ORDER BY name");
     if (rows.empty()) { std::cout << "Aucun cours.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(25) << "Cours"
-              << std::setw(10) << "Crédits" << "\n";
-    std::cout << std::string(40, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(25) << row["name"]
-                  << std::setw(10) << row["credits"] << "\n";
-    }
+    printTable(COURSE_COLUMNS, rows);
 }
 
 void Prof::listGrades() {
-    auto rows = db.query(
-        "SELECT g.id, s.name AS student, c.name AS course, g.grade, g.date_recorded "
-        "FROM grades g "
-        "JOIN students s ON g.student_id = s.id "
-        "JOIN courses  c ON g.course_id  = c.id "
-        "ORDER BY s.name, c.name");
-
-    if (rows.empty()) { std::cout << "Aucune note.\n"; return; }
-
-    std::cout << "\n" << std::left
-              << std::setw(5)  << "ID"
-              << std::setw(25) << "Étudiant"
-              << std::setw(25) << "Cours"
-              << std::setw(8)  << "Note"
-              << std::setw(12) << "Date" << "\n";
-    std::cout << std::string(75, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(5)  << row["id"]
-                  << std::setw(25) << row["student"]
-                  << std::setw(25) << row["course"]
-                  << std::setw(8)  << row["grade"]
-                  << std::setw(12) << row["date_recorded"] << "\n";
-    }
+    if (!KeysetPager(db, GRADES_PAGE).browse(printGrades))
+        std::cout << "Aucune note.\n";
 }
 
 void Prof::addGrade() {
-    listStudents();
-    int sId;
-    std::cout << "ID étudiant : "; std::cin >> sId; std::cin.ignore();
+    RecordSelector selector(db, &studentNames, &courseNames);
+    int sId = selector.selectStudent();
+    if (sId < 0) { std::cout << "Opération annulée.\n"; return; }
 
-    listCourses();
-    int cId;
-    std::cout << "ID cours    : "; std::cin >> cId; std::cin.ignore();
+    int cId = selector.selectCourse();
+    if (cId < 0) { std::cout << "Opération annulée.\n"; return; }
 
     std::string grade;
     std::cout << "Note (0-20) : "; std::getline(std::cin, grade);
 
-    std::string sql = "INSERT INTO grades (student_id, course_id, grade) VALUES ("
-        + std::to_string(sId) + ", "
-        + std::to_string(cId) + ", "
-        + db.escape(grade) + ")";
+    double value;
+    if (!GradeSession::parseGrade(grade, value)) { std::cout << "✗ Note invalide (0 à 20).\n"; return; }
 
-    if (db.execute(sql))
+    if (GradeRepository(db).add(sId, cId, value)) {
+        ResultsEngine(db).refreshStudent(sId);
         std::cout << "✓ Note ajoutée.\n";
-    else
+    } else
         std::cout << "✗ Erreur lors de l'ajout.\n";
 }
 
+void Prof::enterCourseGrades() {
+    int cId = RecordSelector(db, &studentNames, &courseNames).selectCourse();
+    if (cId < 0) { std::cout << "Opération annulée.\n"; return; }
+    GradeSession(db, cId, &studentNames).run();
+}
+
 void Prof::updateGrade() {
-    listGrades();
-    int id;
-    std::cout << "ID de la note à modifier : "; std::cin >> id; std::cin.ignore();
+    int id = RecordSelector(db).selectGrade();
+    if (id < 0) { std::cout << "Opération annulée.\n"; return; }
 
     std::string grade;
     std::cout << "Nouvelle note : "; std::getline(std::cin, grade);
 
-    std::string sql = "UPDATE grades SET grade=" + db.escape(grade)
-        + " WHERE id=" + std::to_string(id);
+    double value;
+    if (!GradeSession::parseGrade(grade, value)) { std::cout << "✗ Note invalide (0 à 20).\n"; return; }
 
-    if (db.execute(sql))
+    ResultsEngine engine(db);
+    if (GradeRepository(db).setGrade(id, value)) {
+        engine.refreshStudent(engine.studentOfGrade(id));
         std::cout << "✓ Note mise à jour.\n";
-    else
+    } else
         std::cout << "✗ Erreur lors de la mise à jour.\n";
 }
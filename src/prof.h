@@ -3,10 +3,13 @@
 
 #include "user.h"
 #include "database.h"
+#include "prefixindex.h"
 
 class Prof : public User {
 private:
-    Database& db;
+    Database&   db;
+    PrefixIndex studentNames;   // complétion des noms, construite à la connexion
+    PrefixIndex courseNames;
 
 public:
     Prof(int id, const std::string& username, const std::string& password, Database& db);
@@ -18,6 +21,7 @@ public:
     void listGrades();            // Voir toutes les notes
     void updateGrade();           // Modifier une note
     void addGrade();              // Ajouter une note
+    void enterCourseGrades();     // Saisie groupée des notes d'un cours, une transaction
 };
 
 #endif // PROF_H
@@ -0,0 +1,272 @@
+#include "querycache.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <iterator>
+
+namespace {
+
+// Tables lues par une requête, relevées par l'autorisateur pendant sa préparation
+struct Dependencies {
+    std::unordered_set<std::string> tables;
+    bool                            cacheable = true;
+};
+
+// Fonctions dont le résultat change d'un appel à l'autre
+const char* const VOLATILE_FUNCTIONS[] = {
+    "random", "randomblob", "changes", "total_changes", "last_insert_rowid"};
+
+bool equalsNoCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i)
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i])))
+            return false;
+    return true;
+}
+
+bool isWordChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_';
+}
+
+// Taille approximative d'un résultat en mémoire : nœuds des Row et chaînes hors SSO
+size_t footprint(const ResultSet& rows) {
+    constexpr size_t NODE = sizeof(Row::value_type) + 32;
+    size_t bytes = rows.capacity() * sizeof(Row);
+    for (const auto& row : rows)
+        for (const auto& [column, value] : row) {
+            bytes += NODE;
+            if (column.size() > 15) bytes += column.capacity() + 1;
+            if (value.size() > 15)  bytes += value.capacity() + 1;
+        }
+    return bytes;
+}
+
+} // namespace
+
+QueryCache::QueryCache(Database& db, size_t budget)
+    : db(db), budget(budget), changes(db.subscribe()),
+      versions(db, "SELECT data_version, schema_version FROM pragma_data_version, pragma_schema_version") {}
+
+QueryCache::~QueryCache() {
+    if (changes) db.unsubscribe(changes);
+}
+
+// ─── Normalisation ─────────────────────────────────────────────────────────
+
+bool QueryCache::normalize(const std::string& sql, std::string& out) {
+    out.clear();
+    out.reserve(sql.size());
+    bool   space = false;
+    size_t i = 0, n = sql.size();
+    while (i < n) {
+        char c = sql[i];
+        if (std::isspace(static_cast<unsigned char>(c))) { space = true; ++i; continue; }
+        if (c == '-' && i + 1 < n && sql[i + 1] == '-') {          // commentaire de ligne
+            while (i < n && sql[i] != '\n') ++i;
+            space = true;
+            continue;
+        }
+        if (c == '/' && i + 1 < n && sql[i + 1] == '*') {          // commentaire de bloc
+            size_t end = sql.find("*/", i + 2);
+            i = end == std::string::npos ? n : end + 2;
+            space = true;
+            continue;
+        }
+        if (c == ';') {
+            // Seuls des espaces ou d'autres ';' peuvent suivre
+            while (++i < n)
+                if (!std::isspace(static_cast<unsigned char>(sql[i])) && sql[i] != ';') return false;
+            break;
+        }
+        if (space && !out.empty()) out += ' ';
+        space = false;
+
+        if (c == '\'' || c == '"' || c == '`' || c == '[') {       // chaîne ou identifiant cité
+            char close = c == '[' ? ']' : c;
+            size_t start = i++;
+            while (i < n) {
+                if (sql[i] == close) {
+                    if (close != ']' && i + 1 < n && sql[i + 1] == close) { i += 2; continue; }
+                    break;
+                }
+                ++i;
+            }
+            i = std::min(i + 1, n);
+            if (c == '\'' && equalsNoCase(std::string_view(sql).substr(start, i - start), "'now'"))
+                return false;
+            out.append(sql, start, i - start);
+            continue;
+        }
+        if (isWordChar(c)) {
+            size_t start = i;
+            while (i < n && isWordChar(sql[i])) ++i;
+            std::string_view word = std::string_view(sql).substr(start, i - start);
+            if (equalsNoCase(word, "CURRENT_DATE") || equalsNoCase(word, "CURRENT_TIME") ||
+                equalsNoCase(word, "CURRENT_TIMESTAMP"))
+                return false;
+            out.append(word);
+            continue;
+        }
+        out += c;
+        ++i;
+    }
+    return true;
+}
+
+// ─── Dépendances (autorisateur) ────────────────────────────────────────────
+
+int QueryCache::authorize(void* data, int action, const char* arg1, const char* arg2,
+                          const char* dbName, const char*) {
+    auto* deps = static_cast<Dependencies*>(data);
+    switch (action) {
+        case SQLITE_SELECT:
+        case SQLITE_RECURSIVE:
+            break;
+        case SQLITE_READ:
+            // Tables système et pragmas : pas de hook pour leurs changements
+            if (!dbName || std::strcmp(dbName, "main") != 0 || !arg1 ||
+                std::strncmp(arg1, "sqlite_", 7) == 0 || std::strncmp(arg1, "pragma_", 7) == 0)
+                deps->cacheable = false;
+            else
+                deps->tables.insert(arg1);
+            break;
+        case SQLITE_FUNCTION:
+            for (const char* name : VOLATILE_FUNCTIONS)
+                if (arg2 && equalsNoCase(arg2, name)) deps->cacheable = false;
+            break;
+        default:
+            deps->cacheable = false;   // écriture, PRAGMA, ATTACH, transaction...
+    }
+    return SQLITE_OK;
+}
+
+// ─── Invalidation ──────────────────────────────────────────────────────────
+
+void QueryCache::sync() {
+    // Écritures d'autres connexions, ou schéma modifié : plus rien n'est sûr
+    versions.reset();
+    if (versions.step()) {
+        long long data = versions.getInt(0), schema = versions.getInt(1);
+        if ((data != dataVersion || schema != schemaVersion) && dataVersion >= 0) {
+            stats.invalidations += static_cast<long long>(entries.size());
+            clear();
+        }
+        dataVersion   = data;
+        schemaVersion = schema;
+    }
+    versions.reset();   // libère la transaction de lecture
+
+    if (!changes) return;
+    RowChange change;
+    while (changes->poll(change)) invalidate(change.table);
+    if (changes->overflowed()) {
+        stats.invalidations += static_cast<long long>(entries.size());
+        clear();
+    }
+}
+
+void QueryCache::invalidate(const std::string& table) {
+    auto drop = [this](const std::string& name) {
+        auto it = byTable.find(name);
+        if (it == byTable.end()) return;
+        std::unordered_set<std::string> keys = std::move(it->second);
+        byTable.erase(it);
+        for (const auto& key : keys) {
+            auto entry = entries.find(key);
+            if (entry == entries.end()) continue;
+            erase(entry->second);
+            ++stats.invalidations;
+        }
+    };
+    drop(table);
+    // Tables virtuelles (FTS5) : leurs écritures arrivent sur <nom>_data, <nom>_idx...
+    for (size_t p = table.find('_'); p != std::string::npos; p = table.find('_', p + 1))
+        drop(table.substr(0, p));
+}
+
+void QueryCache::erase(EntryList::iterator it) {
+    for (const auto& table : it->tables) {
+        auto keys = byTable.find(table);
+        if (keys == byTable.end()) continue;
+        keys->second.erase(it->key);
+        if (keys->second.empty()) byTable.erase(keys);
+    }
+    used -= it->bytes;
+    entries.erase(it->key);
+    lru.erase(it);
+}
+
+void QueryCache::clear() {
+    lru.clear();
+    entries.clear();
+    byTable.clear();
+    used = 0;
+}
+
+// ─── Lecture / mise en cache ───────────────────────────────────────────────
+
+void QueryCache::store(std::string key, ResultSet rows, std::vector<std::string> tables) {
+    size_t bytes = footprint(rows) + key.size() + sizeof(Entry);
+    if (bytes > budget / 4) return;   // un gros résultat viderait le cache pour une seule entrée
+
+    lru.push_front({std::move(key), std::move(rows), std::move(tables), bytes});
+    auto it = lru.begin();
+    entries.emplace(it->key, it);
+    for (const auto& table : it->tables) byTable[table].insert(it->key);
+    used += bytes;
+    while (used > budget && lru.size() > 1) {
+        erase(std::prev(lru.end()));
+        ++stats.evictions;
+    }
+}
+
+bool QueryCache::fetch(const std::string& sql, const std::vector<std::string>& params, ResultSet& out) {
+    std::string key;
+    if (!sqlite3_get_autocommit(db.getHandle()) || !normalize(sql, key)) {
+        ++stats.bypassed;
+        return false;
+    }
+    for (const auto& p : params) {
+        if (equalsNoCase(p, "now")) { ++stats.bypassed; return false; }
+        key += '\0';
+        key += std::to_string(p.size()) + ":" + p;
+    }
+
+    sync();
+    auto hit = entries.find(key);
+    if (hit != entries.end()) {
+        lru.splice(lru.begin(), lru, hit->second);
+        out = hit->second->rows;
+        ++stats.hits;
+        return true;
+    }
+
+    Dependencies deps;
+    sqlite3_set_authorizer(db.getHandle(), &QueryCache::authorize, &deps);
+    Statement stmt(db, sql);
+    sqlite3_set_authorizer(db.getHandle(), nullptr, nullptr);
+
+    ResultSet rows;
+    if (stmt.isValid()) {
+        for (size_t i = 0; i < params.size(); ++i)
+            stmt.bind(static_cast<int>(i + 1), params[i]);
+        while (stmt.step()) rows.push_back(stmt.getRow());
+    }
+    if (!stmt.isValid() || !stmt.ok() || !deps.cacheable) {
+        ++stats.bypassed;
+        out = std::move(rows);
+        return true;
+    }
+    ++stats.misses;
+    out = rows;
+    store(std::move(key), std::move(rows), std::vector<std::string>(deps.tables.begin(), deps.tables.end()));
+    return true;
+}
+
+QueryCacheStats QueryCache::statistics() const {
+    QueryCacheStats s = stats;
+    s.entries = entries.size();
+    s.bytes   = used;
+    s.budget  = budget;
+    return s;
+}
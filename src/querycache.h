@@ -0,0 +1,86 @@
+#ifndef QUERYCACHE_H
+#define QUERYCACHE_H
+
+#include "database.h"
+#include <list>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Compteurs du cache (depuis son activation)
+struct QueryCacheStats {
+    long long hits          = 0;
+    long long misses        = 0;   // exécutées puis mises en cache
+    long long bypassed      = 0;   // non cachables : transaction ouverte, écriture, random(), 'now'...
+    long long invalidations = 0;   // entrées retirées par une écriture sur une table lue
+    long long evictions     = 0;   // entrées retirées pour tenir le budget mémoire
+    size_t    entries       = 0;
+    size_t    bytes         = 0;
+    size_t    budget        = 0;
+};
+
+// Cache des résultats de Database::query(), clé = SQL normalisé + paramètres liés.
+// Chaque entrée retient les tables lues par sa requête (autorisateur SQLite pendant la
+// préparation) ; une écriture sur l'une d'elles la retire :
+//  - changements validés sur la connexion : abonnement au ChangeFeed (grades en
+//    disposition groupée compris) ;
+//  - écritures d'autres connexions ou changement de schéma : PRAGMA data_version /
+//    schema_version, tout le cache est vidé.
+// Rien n'est lu ni écrit dans le cache pendant une transaction explicite.
+// Éviction LRU au-delà du budget mémoire (estimation de la taille des Row).
+class QueryCache {
+public:
+    static constexpr size_t DEFAULT_BUDGET = 8u << 20;
+
+private:
+    struct Entry {
+        std::string              key;
+        ResultSet                rows;
+        std::vector<std::string> tables;
+        size_t                   bytes;
+    };
+    using EntryList = std::list<Entry>;
+
+    Database&                                                        db;
+    size_t                                                           budget;
+    size_t                                                           used = 0;
+    EntryList                                                        lru;       // plus récente en tête
+    std::unordered_map<std::string, EntryList::iterator>             entries;
+    std::unordered_map<std::string, std::unordered_set<std::string>> byTable;   // table → clés
+    std::shared_ptr<ChangeSubscription>                              changes;
+    Statement                                                        versions;
+    long long                                                        dataVersion   = -1;
+    long long                                                        schemaVersion = -1;
+    QueryCacheStats                                                  stats;
+
+    void sync();   // applique les écritures survenues depuis le dernier appel
+    void invalidate(const std::string& table);
+    void erase(EntryList::iterator it);
+    void store(std::string key, ResultSet rows, std::vector<std::string> tables);
+
+    static int authorize(void* deps, int action, const char* arg1, const char* arg2,
+                         const char* dbName, const char* trigger);
+
+public:
+    QueryCache(Database& db, size_t budget = DEFAULT_BUDGET);
+    ~QueryCache();
+
+    QueryCache(const QueryCache&) = delete;
+    QueryCache& operator=(const QueryCache&) = delete;
+
+    // Espaces hors chaînes réduits à un seul, ';' final retiré. Faux si sql contient
+    // plusieurs requêtes ou lit l'heure courante ('now', CURRENT_TIMESTAMP...).
+    static bool normalize(const std::string& sql, std::string& out);
+
+    // Résultat de sql (paramètres liés dans l'ordre), depuis le cache ou exécuté puis retenu.
+    // Faux si la requête doit passer par le chemin normal (transaction ouverte, plusieurs
+    // requêtes) : out est alors inchangé.
+    bool fetch(const std::string& sql, const std::vector<std::string>& params, ResultSet& out);
+
+    void            clear();
+    QueryCacheStats statistics() const;
+};
+
+#endif // QUERYCACHE_H
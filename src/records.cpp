@@ -0,0 +1,82 @@
+#include "records.h"
+
+// ID de la ligne que vient d'insérer cmd, -1 si l'insertion a échoué
+template <typename... Params>
+static long long insertedId(const Database& db, TypedCommand<Params...>& cmd) {
+    return cmd.run() ? static_cast<long long>(sqlite3_last_insert_rowid(db.getHandle())) : -1;
+}
+
+// ─── Utilisateurs ──────────────────────────────────────────────────────────
+
+std::optional<UserRecord> UserRepository::authenticate(const std::string& username,
+                                                       const std::string& password) const {
+    return TypedQuery<UserRecord, std::string, std::string>(
+               db, selectSql() + " WHERE username = ? AND password = ?")
+        .bind(username, password)
+        .one();
+}
+
+long long UserRepository::add(const std::string& username, const std::string& password, const std::string& role) {
+    TypedCommand<std::string, std::string, std::string> insert(
+        db, "INSERT INTO users (username, password, role) VALUES (?, ?, ?)");
+    insert.bind(username, password, role);
+    return insertedId(db, insert);
+}
+
+// ─── Étudiants ─────────────────────────────────────────────────────────────
+
+std::optional<StudentRecord> StudentRepository::ofUser(long long userId) const {
+    return TypedQuery<StudentRecord, long long>(
+               db, selectSql() + " WHERE email = (SELECT email FROM users WHERE id = ?)")
+        .bind(userId)
+        .one();
+}
+
+long long StudentRepository::add(const std::string& name, const std::string& email, const std::string& birthdate) {
+    TypedCommand<std::string, std::string, std::string> insert(
+        db, "INSERT INTO students (name, email, birthdate) VALUES (?, ?, ?)");
+    insert.bind(name, email, birthdate);
+    return insertedId(db, insert);
+}
+
+bool StudentRepository::update(long long id, const std::string& name, const std::string& email) {
+    TypedCommand<std::string, std::string, long long> update(
+        db, "UPDATE students SET name = ?, email = ? WHERE id = ?");
+    return update.bind(name, email, id).run();
+}
+
+// ─── Cours ─────────────────────────────────────────────────────────────────
+
+int CourseRepository::totalCredits() const {
+    return TypedQuery<int>(db, "SELECT IFNULL(SUM(credits), 0) FROM courses").one().value_or(0);
+}
+
+long long CourseRepository::add(const std::string& name, const std::string& description, int credits) {
+    TypedCommand<std::string, std::string, int> insert(
+        db, "INSERT INTO courses (name, description, credits) VALUES (?, ?, ?)");
+    insert.bind(name, description, credits);
+    return insertedId(db, insert);
+}
+
+// ─── Notes ─────────────────────────────────────────────────────────────────
+
+std::optional<double> GradeRepository::weightedAverage(long long studentId) const {
+    auto avg = TypedQuery<std::optional<double>, long long>(
+                   db, "SELECT SUM(g.grade * c.credits) / SUM(c.credits) "
+                       "FROM grades g JOIN courses c ON g.course_id = c.id "
+                       "WHERE g.student_id = ?")
+                   .bind(studentId)
+                   .one();
+    return avg ? *avg : std::nullopt;
+}
+
+bool GradeRepository::add(long long studentId, long long courseId, double grade) {
+    TypedCommand<long long, long long, double> insert(
+        db, "INSERT INTO grades (student_id, course_id, grade) VALUES (?, ?, ?)");
+    return insert.bind(studentId, courseId, grade).run();
+}
+
+bool GradeRepository::setGrade(long long id, double grade) {
+    TypedCommand<double, long long> update(db, "UPDATE grades SET grade = ? WHERE id = ?");
+    return update.bind(grade, id).run();
+}
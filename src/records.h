@@ -0,0 +1,335 @@
+#ifndef RECORDS_H
+#define RECORDS_H
+
+#include "database.h"
+#include <cstddef>
+#include <iostream>
+#include <iterator>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// ─── Enregistrements ───────────────────────────────────────────────────────
+
+struct UserRecord {
+    long long   id = 0;
+    std::string username;
+    std::string password;
+    std::string role;       // admin, prof ou student
+};
+
+struct StudentRecord {
+    long long   id = 0;
+    std::string name;
+    std::string email;
+    std::string birthdate;  // "YYYY-MM-DD"
+};
+
+struct CourseRecord {
+    long long   id = 0;
+    std::string name;
+    std::string description;
+    int         credits = 0;
+};
+
+struct GradeRecord {
+    long long id           = 0;
+    long long studentId    = 0;
+    long long courseId     = 0;
+    double    grade        = 0;
+    long long dateRecorded = 0;   // jours depuis le 1970-01-01 (dates.h)
+};
+
+// Correspondance colonnes ↔ champs d'un enregistrement : noms des colonnes de sa table et
+// pointeurs vers les champs, dans le même ordre (id en premier). Lu à la compilation par
+// TypedQuery : ni recherche par nom de colonne ni conversion depuis le texte.
+template <typename Record> struct RecordColumns;
+
+template <> struct RecordColumns<UserRecord> {
+    static constexpr const char* table   = "users";
+    static constexpr const char* names[] = {"id", "username", "password", "role"};
+    static constexpr auto fields = std::make_tuple(&UserRecord::id, &UserRecord::username,
+                                                   &UserRecord::password, &UserRecord::role);
+};
+
+template <> struct RecordColumns<StudentRecord> {
+    static constexpr const char* table   = "students";
+    static constexpr const char* names[] = {"id", "name", "email", "birthdate"};
+    static constexpr auto fields = std::make_tuple(&StudentRecord::id, &StudentRecord::name,
+                                                   &StudentRecord::email, &StudentRecord::birthdate);
+};
+
+template <> struct RecordColumns<CourseRecord> {
+    static constexpr const char* table   = "courses";
+    static constexpr const char* names[] = {"id", "name", "description", "credits"};
+    static constexpr auto fields = std::make_tuple(&CourseRecord::id, &CourseRecord::name,
+                                                   &CourseRecord::description, &CourseRecord::credits);
+};
+
+template <> struct RecordColumns<GradeRecord> {
+    static constexpr const char* table   = "grades";
+    static constexpr const char* names[] = {"id", "student_id", "course_id", "grade", "date_recorded"};
+    static constexpr auto fields = std::make_tuple(&GradeRecord::id, &GradeRecord::studentId,
+                                                   &GradeRecord::courseId, &GradeRecord::grade,
+                                                   &GradeRecord::dateRecorded);
+};
+
+// ─── Colonnes et paramètres typés ──────────────────────────────────────────
+
+// Lecture d'une colonne et liaison d'un paramètre pour un type C++.
+// NULL se lit 0 ou "" ; std::optional<T> le distingue (nullopt) et se lie à NULL.
+template <typename T> struct ColumnTraits {
+    static constexpr bool supported = false;
+};
+
+template <> struct ColumnTraits<int> {
+    static constexpr bool supported = true;
+    static int  read(const Statement& s, int col)        { return static_cast<int>(s.getInt(col)); }
+    static void bind(Statement& s, int index, int value) { s.bind(index, value); }
+};
+
+template <> struct ColumnTraits<long long> {
+    static constexpr bool supported = true;
+    static long long read(const Statement& s, int col)              { return s.getInt(col); }
+    static void      bind(Statement& s, int index, long long value) { s.bind(index, value); }
+};
+
+template <> struct ColumnTraits<double> {
+    static constexpr bool supported = true;
+    static double read(const Statement& s, int col)           { return s.getDouble(col); }
+    static void   bind(Statement& s, int index, double value) { s.bind(index, value); }
+};
+
+template <> struct ColumnTraits<std::string> {
+    static constexpr bool supported = true;
+    static std::string read(const Statement& s, int col) { return std::string(s.getView(col)); }
+    static void bind(Statement& s, int index, const std::string& value) { s.bind(index, value); }
+};
+
+template <typename T> struct ColumnTraits<std::optional<T>> {
+    static constexpr bool supported = ColumnTraits<T>::supported;
+    static std::optional<T> read(const Statement& s, int col) {
+        if (s.isNull(col)) return std::nullopt;
+        return ColumnTraits<T>::read(s, col);
+    }
+    static void bind(Statement& s, int index, const std::optional<T>& value) {
+        if (value) ColumnTraits<T>::bind(s, index, *value);
+        else       s.bindNull(index);
+    }
+};
+
+// Ligne lue d'une requête : valeur seule (une colonne), std::tuple (une colonne par
+// élément) ou enregistrement (colonnes de RecordColumns)
+template <typename T, typename = void> struct RowReader {
+    static_assert(ColumnTraits<T>::supported, "RowReader : type de colonne non pris en charge");
+    static constexpr int columns = 1;
+    static T read(const Statement& s) { return ColumnTraits<T>::read(s, 0); }
+};
+
+template <typename... Ts> struct RowReader<std::tuple<Ts...>> {
+    static_assert((ColumnTraits<Ts>::supported && ...), "RowReader : type de colonne non pris en charge");
+    static constexpr int columns = static_cast<int>(sizeof...(Ts));
+
+    template <size_t... I>
+    static std::tuple<Ts...> readAll(const Statement& s, std::index_sequence<I...>) {
+        return std::tuple<Ts...>(ColumnTraits<Ts>::read(s, static_cast<int>(I))...);
+    }
+    static std::tuple<Ts...> read(const Statement& s) { return readAll(s, std::index_sequence_for<Ts...>{}); }
+};
+
+template <typename Record>
+struct RowReader<Record, std::void_t<decltype(RecordColumns<Record>::fields)>> {
+    using Fields = std::decay_t<decltype(RecordColumns<Record>::fields)>;
+    static constexpr int columns = static_cast<int>(std::tuple_size_v<Fields>);
+    static_assert(std::size(RecordColumns<Record>::names) == std::tuple_size_v<Fields>,
+                  "RecordColumns : autant de noms de colonnes que de champs");
+
+    template <size_t... I>
+    static void readAll(const Statement& s, Record& r, std::index_sequence<I...>) {
+        constexpr const Fields& fields = RecordColumns<Record>::fields;
+        ((r.*std::get<I>(fields) =
+              ColumnTraits<std::decay_t<decltype(r.*std::get<I>(fields))>>::read(s, static_cast<int>(I))), ...);
+    }
+    static Record read(const Statement& s) {
+        Record r{};
+        readAll(s, r, std::make_index_sequence<std::tuple_size_v<Fields>>{});
+        return r;
+    }
+};
+
+// Argument accepté pour un paramètre : conversion implicite, sans réel → entier
+template <typename T> struct Unwrapped                   { using type = T; };
+template <typename T> struct Unwrapped<std::optional<T>> { using type = T; };
+
+template <typename Arg, typename Param>
+constexpr bool isBindable = std::is_convertible_v<const Arg&, Param> &&
+                            !(std::is_floating_point_v<Arg> && std::is_integral_v<typename Unwrapped<Param>::type>);
+
+// Requête préparée typée. Result : type d'une ligne (voir RowReader ; void pour une
+// écriture, voir TypedCommand). Params : types des paramètres ?1, ?2... dans l'ordre.
+//  - bind() avec un mauvais nombre d'arguments ou un type incompatible ne compile pas ;
+//  - le nombre de colonnes et de paramètres du SQL est vérifié à la préparation
+//    ([DB ERROR], requête invalide) ;
+//  - les colonnes sont lues par sqlite3_column_int64 / _double / _text, sans Row.
+template <typename Result, typename... Params>
+class TypedQuery {
+    static_assert((ColumnTraits<Params>::supported && ...), "TypedQuery : type de paramètre non pris en charge");
+
+public:
+    using Value = std::conditional_t<std::is_void_v<Result>, std::tuple<>, Result>;
+
+private:
+    Statement stmt;
+    bool      valid;
+
+    template <typename... Args>
+    static constexpr bool bindable() {
+        if constexpr (sizeof...(Args) != sizeof...(Params)) return false;
+        else return (isBindable<Args, Params> && ...);
+    }
+
+    template <size_t... I, typename... Args>
+    void bindAll(std::index_sequence<I...>, const Args&... args) {
+        (ColumnTraits<Params>::bind(stmt, static_cast<int>(I + 1), Params(args)), ...);
+    }
+
+public:
+    TypedQuery(const Database& db, const std::string& sql) : stmt(db, sql), valid(stmt.isValid()) {
+        if (!valid) return;
+        constexpr int params = static_cast<int>(sizeof...(Params));
+        if (stmt.columnCount() != RowReader<Value>::columns || stmt.parameterCount() != params) {
+            std::cerr << "[DB ERROR] " << stmt.columnCount() << " colonne(s) et " << stmt.parameterCount()
+                      << " paramètre(s) au lieu de " << RowReader<Value>::columns << " et " << params
+                      << " : " << sql << std::endl;
+            valid = false;
+        }
+    }
+
+    TypedQuery(const TypedQuery&) = delete;
+    TypedQuery& operator=(const TypedQuery&) = delete;
+
+    bool isValid() const { return valid; }
+    bool ok() const      { return valid && stmt.ok(); }
+
+    // Lie tous les paramètres (requête remise au début)
+    template <typename... Args>
+    TypedQuery& bind(const Args&... args) {
+        static_assert(sizeof...(Args) == sizeof...(Params), "TypedQuery::bind : nombre de paramètres incorrect");
+        static_assert(sizeof...(Args) != sizeof...(Params) || bindable<Args...>(),
+                      "TypedQuery::bind : type de paramètre incompatible");
+        if constexpr (bindable<Args...>()) {
+            stmt.reset();
+            bindAll(std::index_sequence_for<Params...>{}, args...);
+        }
+        return *this;
+    }
+
+    // Ligne suivante dans out ; faux à la fin (ou en cas d'erreur, voir ok())
+    bool next(Value& out) {
+        if (!valid || !stmt.step()) return false;
+        out = RowReader<Value>::read(stmt);
+        return true;
+    }
+
+    // Première ligne, nullopt si aucune
+    std::optional<Value> one() {
+        Value value{};
+        bool found = next(value);
+        if (valid) stmt.reset();   // libère la lecture sans attendre la destruction
+        return found ? std::optional<Value>(std::move(value)) : std::nullopt;
+    }
+
+    std::vector<Value> all() {
+        std::vector<Value> rows;
+        Value value{};
+        while (next(value)) rows.push_back(std::move(value));
+        return rows;
+    }
+
+    // Exécute jusqu'au bout (INSERT / UPDATE / DELETE)
+    bool run() { return valid && stmt.run(); }
+};
+
+template <typename... Params>
+using TypedCommand = TypedQuery<void, Params...>;
+
+// ─── Dépôts ────────────────────────────────────────────────────────────────
+
+// Lecture des enregistrements d'une table par leur ID ; les dépôts ajoutent leurs
+// requêtes propres
+template <typename Record>
+class Repository {
+protected:
+    Database& db;
+
+    // "SELECT id, name, ... FROM table" dans l'ordre de RecordColumns
+    static std::string selectSql() {
+        std::string sql = "SELECT ";
+        const char* separator = "";
+        for (const char* column : RecordColumns<Record>::names) {
+            sql += separator;
+            sql += column;
+            separator = ", ";
+        }
+        return sql + " FROM " + RecordColumns<Record>::table;
+    }
+
+public:
+    explicit Repository(Database& db) : db(db) {}
+
+    std::optional<Record> find(long long id) const {
+        return TypedQuery<Record, long long>(db, selectSql() + " WHERE id = ?").bind(id).one();
+    }
+};
+
+class UserRepository : public Repository<UserRecord> {
+public:
+    using Repository::Repository;
+
+    // Compte correspondant à l'identifiant et au mot de passe
+    std::optional<UserRecord> authenticate(const std::string& username, const std::string& password) const;
+
+    // Retournent l'ID créé, -1 en cas d'erreur
+    long long add(const std::string& username, const std::string& password, const std::string& role);
+};
+
+class StudentRepository : public Repository<StudentRecord> {
+public:
+    using Repository::Repository;
+
+    // Fiche étudiant d'un compte (même email)
+    std::optional<StudentRecord> ofUser(long long userId) const;
+
+    long long add(const std::string& name, const std::string& email, const std::string& birthdate);
+
+    // Faux en cas d'erreur (email déjà pris...)
+    bool update(long long id, const std::string& name, const std::string& email);
+};
+
+class CourseRepository : public Repository<CourseRecord> {
+public:
+    using Repository::Repository;
+
+    int totalCredits() const;   // crédits du catalogue
+
+    long long add(const std::string& name, const std::string& description, int credits);
+};
+
+class GradeRepository : public Repository<GradeRecord> {
+public:
+    using Repository::Repository;
+
+    // Moyenne pondérée par les crédits des cours, nullopt sans note
+    std::optional<double> weightedAverage(long long studentId) const;
+
+    // Ajout daté du jour ; sans ID retourné (en disposition groupée, l'ID est attribué
+    // par trigger et last_insert_rowid ne le reflète pas)
+    bool add(long long studentId, long long courseId, double grade);
+
+    bool setGrade(long long id, double grade);
+};
+
+#endif // RECORDS_H
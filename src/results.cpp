@@ -0,0 +1,187 @@
+#include "results.h"
+#include "records.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+
+// Une ligne par (étudiant, cours) : l'ordre de idx_grades_student (ou de la clé primaire
+// en disposition groupée) évite tout tri. Partir de students garde les étudiants sans
+// note : une ligne sans cours (COUNT 0, crédits NULL), pour un résultat REDOUBLE.
+static const char* GRADES_BY_COURSE_SQL =
+    "SELECT s.id, SUM(g.grade), COUNT(g.id), MAX(g.grade), c.credits "
+    "FROM students s "
+    "LEFT JOIN grades g ON g.student_id = s.id "
+    "LEFT JOIN courses c ON g.course_id = c.id "
+    "WHERE s.id BETWEEN ? AND ? "
+    "GROUP BY s.id, g.course_id";
+
+static const char* UPSERT_RESULT_SQL =
+    "INSERT OR REPLACE INTO results (student_id, weighted_avg, credits, credits_earned, "
+    "credits_outstanding, mention, decision) VALUES (?, ?, ?, ?, ?, ?, ?)";
+
+std::string mentionFor(double avg) {
+    if (avg >= 16)      return "Très Bien";
+    else if (avg >= 14) return "Bien";
+    else if (avg >= 12) return "Assez Bien";
+    else if (avg >= 10) return "Passable";
+    else                return "Insuffisant";
+}
+
+std::string decisionFor(const StudentResult& result) {
+    return result.creditsOutstanding <= 0 ? "ADMIS" : "REDOUBLE";
+}
+
+static void bindResult(Statement& stmt, const StudentResult& r) {
+    stmt.bind(1, r.studentId);
+    stmt.bind(2, r.weightedAvg);
+    stmt.bind(3, r.credits);
+    stmt.bind(4, r.creditsEarned);
+    stmt.bind(5, r.creditsOutstanding);
+    // Sans note dans un cours à crédits, pas de moyenne : pas de mention (comme les relevés)
+    stmt.bind(6, r.credits > 0 ? mentionFor(r.weightedAvg) : std::string("-"));
+    stmt.bind(7, decisionFor(r));
+}
+
+ResultsEngine::ResultsEngine(Database& db) : db(db) {}
+
+int ResultsEngine::catalogCredits() {
+    return CourseRepository(db).totalCredits();
+}
+
+void ResultsEngine::collect(Statement& stmt, int catalog, std::vector<StudentResult>& out) {
+    int    current = -1;
+    double weighted = 0;
+    long long weight = 0;
+    StudentResult r{};
+
+    auto flush = [&]() {
+        if (current < 0) return;
+        r.studentId          = current;
+        r.weightedAvg        = weight > 0 ? weighted / static_cast<double>(weight) : 0;
+        r.creditsOutstanding = std::max(0, catalog - r.creditsEarned);
+        out.push_back(r);
+    };
+
+    while (stmt.step()) {
+        int student = static_cast<int>(stmt.getInt(0));
+        if (student != current) {
+            flush();
+            current = student;
+            weighted = 0;
+            weight = 0;
+            r = StudentResult{};
+        }
+        int credits = static_cast<int>(stmt.getInt(4));
+        weighted += stmt.getDouble(1) * credits;
+        weight   += stmt.getInt(2) * credits;
+        r.credits += credits;
+        if (stmt.getDouble(3) >= PASS_THRESHOLD) r.creditsEarned += credits;
+    }
+    flush();
+}
+
+bool ResultsEngine::computeRange(const std::string& dbPath, int firstId, int lastId, int catalog,
+                                 std::vector<StudentResult>& out) {
+    Database reader(dbPath);
+    if (!reader.connectReadOnly()) return false;
+
+    Statement stmt(reader, GRADES_BY_COURSE_SQL);
+    if (!stmt.isValid()) return false;
+    stmt.bind(1, firstId);
+    stmt.bind(2, lastId);
+    collect(stmt, catalog, out);
+    return stmt.ok();   // SQLITE_BUSY, erreur d'E/S... : tranche incomplète
+}
+
+int ResultsEngine::computeAll() {
+    auto start = std::chrono::steady_clock::now();
+
+    using Bounds = std::tuple<std::optional<int>, std::optional<int>>;
+    auto bounds = TypedQuery<Bounds>(db, "SELECT MIN(id), MAX(id) FROM students").one();
+    if (!bounds || !std::get<0>(*bounds)) {
+        std::cout << "Aucun étudiant.\n";
+        return 0;
+    }
+    int lo = *std::get<0>(*bounds);
+    int hi = *std::get<1>(*bounds);
+    int catalog = catalogCredits();
+
+    // Découpage en tranches d'IDs : plus de tranches que de threads pour équilibrer
+    unsigned nThreads = std::max(1u, std::thread::hardware_concurrency());
+    long long span    = static_cast<long long>(hi) - lo + 1;
+    int nChunks       = static_cast<int>(std::min<long long>(span, nThreads * 8LL));
+    long long step    = (span + nChunks - 1) / nChunks;
+
+    std::vector<std::vector<StudentResult>> partial(nChunks);
+    std::vector<char> chunkOk(nChunks, 0);
+    std::atomic<int> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < nThreads; ++t) {
+        workers.emplace_back([&]() {
+            for (int i = next++; i < nChunks; i = next++) {
+                long long first = lo + i * step;
+                long long last  = std::min<long long>(first + step - 1, hi);
+                chunkOk[i] = computeRange(db.getPath(), static_cast<int>(first), static_cast<int>(last),
+                                          catalog, partial[i]);
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // Une tranche manquante effacerait les résultats de ses étudiants : rien n'est écrit
+    long long failed = std::count(chunkOk.begin(), chunkOk.end(), 0);
+    if (failed > 0) {
+        std::cout << "✗ Calcul interrompu : " << failed << " tranche(s) sur " << nChunks
+                  << " en échec, résultats inchangés.\n";
+        return -1;
+    }
+
+    // Écriture : un seul writer, une seule transaction
+    if (!db.begin()) return -1;
+    if (!db.execute("DELETE FROM results;")) { db.rollback(); return -1; }
+    Statement insert(db, UPSERT_RESULT_SQL);
+    int count = 0, admitted = 0;
+    for (auto& chunk : partial) {
+        for (auto& r : chunk) {
+            bindResult(insert, r);
+            if (!insert.run()) { db.rollback(); return -1; }
+            insert.reset();
+            ++count;
+            if (r.creditsOutstanding <= 0) ++admitted;
+        }
+    }
+    if (!db.commit()) { db.rollback(); return -1; }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "✓ " << count << " résultat(s) calculé(s) en "
+              << std::fixed << std::setprecision(2) << elapsed.count() << " s ("
+              << nThreads << " thread(s)) — " << admitted << " admis, "
+              << (count - admitted) << " redoublement(s)\n";
+    return count;
+}
+
+bool ResultsEngine::refreshStudent(int studentId) {
+    if (studentId < 0) return false;
+
+    std::vector<StudentResult> out;
+    Statement stmt(db, GRADES_BY_COURSE_SQL);
+    stmt.bind(1, studentId);
+    stmt.bind(2, studentId);
+    collect(stmt, catalogCredits(), out);
+    if (!stmt.ok()) return false;
+
+    // Étudiant supprimé entre-temps
+    if (out.empty())
+        return db.execute("DELETE FROM results WHERE student_id=" + std::to_string(studentId));
+
+    Statement upsert(db, UPSERT_RESULT_SQL);
+    bindResult(upsert, out[0]);
+    return upsert.run();
+}
+
+int ResultsEngine::studentOfGrade(int gradeId) {
+    auto grade = GradeRepository(db).find(gradeId);
+    return grade ? static_cast<int>(grade->studentId) : -1;
+}
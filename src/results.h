@@ -0,0 +1,57 @@
+#ifndef RESULTS_H
+#define RESULTS_H
+
+#include "database.h"
+#include <string>
+#include <vector>
+
+// Seuil de validation d'un cours (ECTS acquis si meilleure note >= 10/20)
+constexpr double PASS_THRESHOLD = 10.0;
+
+// Résultat d'un étudiant : moyenne pondérée (Σ note × crédits / Σ crédits)
+// et progression ECTS
+struct StudentResult {
+    int    studentId;
+    double weightedAvg;         // 0 sans note dans un cours à crédits (mention "-")
+    int    credits;             // crédits des cours notés
+    int    creditsEarned;       // crédits des cours validés
+    int    creditsOutstanding;  // crédits du catalogue restant à valider
+};
+
+// Mention correspondant à une moyenne sur 20
+std::string mentionFor(double avg);
+
+// Décision de jury : admis quand tous les crédits du catalogue sont acquis
+std::string decisionFor(const StudentResult& result);
+
+// Calcul des résultats de toute la promotion, réparti sur plusieurs threads,
+// et mise à jour incrémentale d'un étudiant après modification d'une note
+class ResultsEngine {
+private:
+    Database& db;
+
+    int catalogCredits();
+
+    // Agrège les lignes (étudiant, cours) d'une requête en résultats par étudiant
+    static void collect(Statement& stmt, int catalog, std::vector<StudentResult>& out);
+
+    // Travail d'un thread : une connexion en lecture seule par thread.
+    // Faux si la connexion ou la lecture a échoué (out alors incomplet).
+    static bool computeRange(const std::string& dbPath, int firstId, int lastId, int catalog,
+                             std::vector<StudentResult>& out);
+
+public:
+    explicit ResultsEngine(Database& db);
+
+    // Recalcule la table results en une seule transaction.
+    // Retourne le nombre d'étudiants traités, -1 en cas d'erreur.
+    int computeAll();
+
+    // Recalcule uniquement la ligne d'un étudiant (après ajout / modif / suppression de note)
+    bool refreshStudent(int studentId);
+
+    // Étudiant concerné par une note (avant de la modifier ou supprimer), -1 si inconnue
+    int studentOfGrade(int gradeId);
+};
+
+#endif // RESULTS_H
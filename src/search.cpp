@@ -0,0 +1,88 @@
+#include "search.h"
+#include "table.h"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+FullTextSearch::FullTextSearch(Database& db) : db(db) {}
+
+std::string FullTextSearch::matchQuery(const std::string& text) {
+    // Chaque mot devient une chaîne FTS5 entre guillemets : la syntaxe de requête
+    // (AND, NEAR, *, colonnes...) saisie par l'utilisateur n'est pas interprétée
+    std::istringstream words(text);
+    std::string word, query;
+    while (words >> word) {
+        std::string quoted = "\"";
+        for (char c : word) {
+            if (c == '"') quoted += '"';
+            quoted += c;
+        }
+        query += (query.empty() ? "" : " ") + quoted + "\"*";
+    }
+    return query;
+}
+
+// Lignes d'une recherche classée ; le JOIN ne lit que les lignes retenues
+static ResultSet ranked(Database& db, const std::string& sql, const std::string& text, int limit) {
+    ResultSet out;
+    std::string match = FullTextSearch::matchQuery(text);
+    if (match.empty()) return out;
+
+    Statement stmt(db, sql);
+    stmt.bind(1, match);
+    stmt.bind(2, limit);
+    while (stmt.step()) out.push_back(stmt.getRow());
+    return out;
+}
+
+ResultSet FullTextSearch::students(const std::string& text, int limit) {
+    return ranked(db,
+        "SELECT s.id, s.name, s.email FROM students_fts f "
+        "JOIN students s ON s.id = f.rowid "
+        "WHERE students_fts MATCH ?1 ORDER BY bm25(students_fts, 10.0, 2.0) LIMIT ?2",
+        text, limit);
+}
+
+ResultSet FullTextSearch::courses(const std::string& text, int limit) {
+    return ranked(db,
+        "SELECT c.id, c.name, c.description, c.credits FROM courses_fts f "
+        "JOIN courses c ON c.id = f.rowid "
+        "WHERE courses_fts MATCH ?1 ORDER BY bm25(courses_fts, 10.0, 1.0) LIMIT ?2",
+        text, limit);
+}
+
+static constexpr std::array<Column, 3> STUDENT_COLUMNS = {{
+    {"ID", "id", 8}, {"Nom", "name", 30}, {"Email", "email", 30}}};
+
+static constexpr std::array<Column, 4> COURSE_COLUMNS = {{
+    {"ID", "id", 5}, {"Cours", "name", 25}, {"Description", "description", 35},
+    {"Crédits", "credits", 8}}};
+
+void FullTextSearch::prompt() {
+    while (true) {
+        std::string text;
+        std::cout << "\nRecherche (mots ou débuts de mots, Entrée = retour) : ";
+        if (!std::getline(std::cin, text) || matchQuery(text).empty()) return;
+
+        auto start = std::chrono::steady_clock::now();
+        ResultSet studentRows = students(text);
+        ResultSet courseRows  = courses(text);
+        std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+        if (studentRows.empty() && courseRows.empty()) {
+            std::cout << "Aucune correspondance.\n";
+            continue;
+        }
+        if (!studentRows.empty()) {
+            std::cout << "\n-- Étudiants --";
+            printTable(STUDENT_COLUMNS, studentRows);
+        }
+        if (!courseRows.empty()) {
+            std::cout << "\n-- Cours --";
+            printTable(COURSE_COLUMNS, courseRows);
+        }
+        std::cout << "(" << studentRows.size() + courseRows.size() << " résultat(s) les plus pertinents, "
+                  << std::fixed << std::setprecision(1) << elapsed.count() << " ms)\n";
+    }
+}
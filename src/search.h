@@ -0,0 +1,32 @@
+#ifndef SEARCH_H
+#define SEARCH_H
+
+#include "database.h"
+#include <string>
+
+// Recherche plein texte (FTS5) sur students(name, email) et courses(name, description).
+// Les index students_fts / courses_fts sont à contenu externe : ils ne stockent que les
+// termes, tenus à jour par triggers (voir Database::initSchema). Les accents et la
+// casse sont ignorés ; chaque mot saisi est cherché comme préfixe, tous doivent figurer.
+class FullTextSearch {
+public:
+    static constexpr int MAX_RESULTS = 20;
+
+private:
+    Database& db;
+
+public:
+    explicit FullTextSearch(Database& db);
+
+    // "dur jé" → "\"dur\"* \"jé\"*" ; chaîne vide si rien à chercher
+    static std::string matchQuery(const std::string& text);
+
+    // Correspondances classées par pertinence (bm25, le nom pèse plus que le reste)
+    ResultSet students(const std::string& text, int limit = MAX_RESULTS);
+    ResultSet courses(const std::string& text, int limit = MAX_RESULTS);
+
+    // Saisie et affichage des deux recherches, jusqu'à une saisie vide
+    void prompt();
+};
+
+#endif // SEARCH_H
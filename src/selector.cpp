@@ -0,0 +1,169 @@
+#include "selector.h"
+#include "dates.h"
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+RecordSelector::RecordSelector(Database& db, PrefixIndex* studentNames, PrefixIndex* courseNames)
+    : db(db), studentNames(studentNames), courseNames(courseNames) {}
+
+// Correspondances proposées à l'opérateur
+static constexpr std::array<Column, 3> STUDENT_MATCH_COLUMNS = {{
+    {"ID", "id", 7}, {"Nom", "name", 30}, {"Email", "email", 30}}};
+
+static constexpr std::array<Column, 3> COURSE_MATCH_COLUMNS = {{
+    {"ID", "id", 7}, {"Cours", "name", 30}, {"Crédits", "credits", 8}}};
+
+static constexpr std::array<Column, 4> GRADE_CHOICE_COLUMNS = {{
+    {"ID", "id", 7}, {"Cours", "course", 25}, {"Note", "grade", 8}, {"Date", "date_recorded", 12}}};
+
+static bool isNumber(const std::string& text) {
+    return !text.empty() && text.size() < 10
+        && std::all_of(text.begin(), text.end(), [](unsigned char c) { return std::isdigit(c); });
+}
+
+// Motif LIKE 'texte%' : les jokers saisis par l'utilisateur sont échappés
+static std::string likePrefix(const std::string& text) {
+    std::string pattern;
+    for (char c : text) {
+        if (c == '%' || c == '_' || c == '\\') pattern += '\\';
+        pattern += c;
+    }
+    return pattern + "%";
+}
+
+// Borne haute d'un intervalle de préfixe : "abc" → "abd"
+static std::string prefixUpperBound(std::string text) {
+    while (!text.empty() && static_cast<unsigned char>(text.back()) == 0xFF) text.pop_back();
+    if (!text.empty()) text.back() = static_cast<char>(text.back() + 1);
+    return text;
+}
+
+// Ajoute les lignes d'une requête préparée sans doublon d'ID, jusqu'à MAX_MATCHES
+static void appendMatches(Statement& stmt, ResultSet& out) {
+    while (static_cast<int>(out.size()) < MAX_MATCHES && stmt.step()) {
+        Row row = stmt.getRow();
+        bool seen = std::any_of(out.begin(), out.end(),
+                                [&](const Row& r) { return r.at("id") == row.at("id"); });
+        if (!seen) out.push_back(row);
+    }
+}
+
+void RecordSelector::appendCompletions(PrefixIndex* index, const char* sql, const std::string& text,
+                                       ResultSet& out) {
+    Statement byId(db, sql);
+    for (long long id : index->complete(text, MAX_MATCHES)) {
+        byId.bind(1, id);
+        appendMatches(byId, out);
+        byId.reset();
+    }
+}
+
+ResultSet RecordSelector::searchStudents(const std::string& text) {
+    ResultSet out;
+    if (isNumber(text)) {
+        Statement byId(db, "SELECT id, name, email FROM students WHERE id = ?");
+        byId.bind(1, std::stoi(text));
+        appendMatches(byId, out);
+    }
+
+    if (studentNames && studentNames->isReady()) {
+        appendCompletions(studentNames, "SELECT id, name, email FROM students WHERE id = ?", text, out);
+    } else {
+        // idx_students_name_nocase : LIKE 'préfixe%' devient une recherche par intervalle
+        Statement byName(db, "SELECT id, name, email FROM students "
+                             "WHERE name LIKE ? ESCAPE '\\' ORDER BY name COLLATE NOCASE LIMIT ?");
+        byName.bind(1, likePrefix(text));
+        byName.bind(2, MAX_MATCHES);
+        appendMatches(byName, out);
+    }
+
+    // Index UNIQUE de l'email
+    Statement byEmail(db, "SELECT id, name, email FROM students "
+                          "WHERE email >= ? AND email < ? ORDER BY email LIMIT ?");
+    byEmail.bind(1, text);
+    byEmail.bind(2, prefixUpperBound(text));
+    byEmail.bind(3, MAX_MATCHES);
+    appendMatches(byEmail, out);
+    return out;
+}
+
+ResultSet RecordSelector::searchCourses(const std::string& text) {
+    ResultSet out;
+    if (isNumber(text)) {
+        Statement byId(db, "SELECT id, name, credits FROM courses WHERE id = ?");
+        byId.bind(1, std::stoi(text));
+        appendMatches(byId, out);
+    }
+
+    if (courseNames && courseNames->isReady()) {
+        appendCompletions(courseNames, "SELECT id, name, credits FROM courses WHERE id = ?", text, out);
+    } else {
+        Statement byName(db, "SELECT id, name, credits FROM courses "
+                             "WHERE name LIKE ? ESCAPE '\\' ORDER BY name COLLATE NOCASE LIMIT ?");
+        byName.bind(1, likePrefix(text));
+        byName.bind(2, MAX_MATCHES);
+        appendMatches(byName, out);
+    }
+    return out;
+}
+
+int RecordSelector::select(const std::string& prompt,
+                           ResultSet (RecordSelector::*search)(const std::string&),
+                           const std::array<Column, 3>& columns) {
+    while (true) {
+        std::string text;
+        std::cout << prompt;
+        if (!std::getline(std::cin, text) || text.empty()) return -1;
+
+        ResultSet matches = (this->*search)(text);
+        if (matches.empty()) {
+            std::cout << "Aucune correspondance.\n";
+            continue;
+        }
+
+        // Un ID exact ou une seule correspondance : sélection directe
+        if (matches.size() == 1 || (isNumber(text) && matches[0]["id"] == text)) {
+            std::cout << "→ " << matches[0][columns[1].key] << " (ID=" << matches[0]["id"] << ")\n";
+            return std::stoi(matches[0]["id"]);
+        }
+
+        printTable(columns, matches);
+        if (static_cast<int>(matches.size()) == MAX_MATCHES)
+            std::cout << "  ...\n";
+        std::cout << "Affinez la recherche ou saisissez l'ID.\n";
+    }
+}
+
+int RecordSelector::selectStudent() {
+    return select("Étudiant (nom, email ou ID — Entrée = annuler) : ",
+                  &RecordSelector::searchStudents, STUDENT_MATCH_COLUMNS);
+}
+
+int RecordSelector::selectCourse() {
+    return select("Cours (nom ou ID — Entrée = annuler) : ",
+                  &RecordSelector::searchCourses, COURSE_MATCH_COLUMNS);
+}
+
+int RecordSelector::selectGrade() {
+    int sId = selectStudent();
+    if (sId < 0) return -1;
+
+    auto rows = db.query(
+        "SELECT g.id, c.name AS course, g.grade, " + daySql("g.date_recorded") + " AS date_recorded "
+        "FROM grades g JOIN courses c ON g.course_id = c.id "
+        "WHERE g.student_id = " + std::to_string(sId) + " ORDER BY c.name");
+    if (rows.empty()) { std::cout << "Aucune note pour cet étudiant.\n"; return -1; }
+
+    printTable(GRADE_CHOICE_COLUMNS, rows);
+
+    while (true) {
+        std::string text;
+        std::cout << "ID de la note (Entrée = annuler) : ";
+        if (!std::getline(std::cin, text) || text.empty()) return -1;
+        bool listed = std::any_of(rows.begin(), rows.end(),
+                                  [&](const Row& r) { return r.at("id") == text; });
+        if (listed) return std::stoi(text);
+        std::cout << "Cette note n'appartient pas à l'étudiant choisi.\n";
+    }
+}
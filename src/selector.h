@@ -0,0 +1,43 @@
+#ifndef SELECTOR_H
+#define SELECTOR_H
+
+#include "database.h"
+#include "prefixindex.h"
+#include "table.h"
+#include <array>
+#include <string>
+
+// Nombre maximum de correspondances affichées par recherche
+constexpr int MAX_MATCHES = 10;
+
+// Sélection d'un enregistrement par recherche (préfixe du nom, email ou ID)
+// au lieu d'afficher toute la table avant chaque saisie d'ID. Avec un PrefixIndex,
+// les noms sont complétés en mémoire (début de n'importe quel mot, sans accents).
+class RecordSelector {
+private:
+    Database&    db;
+    PrefixIndex* studentNames;   // complétion en mémoire des noms, si fournie et prête
+    PrefixIndex* courseNames;
+
+    // Lignes des IDs complétés par l'index, dans son ordre
+    void appendCompletions(PrefixIndex* index, const char* sql, const std::string& text, ResultSet& out);
+
+    // Boucle commune : saisie, recherche, affinage jusqu'à une correspondance unique.
+    // columns : ID, libellé, détail des correspondances affichées
+    int select(const std::string& prompt, ResultSet (RecordSelector::*search)(const std::string&),
+               const std::array<Column, 3>& columns);
+
+public:
+    explicit RecordSelector(Database& db, PrefixIndex* studentNames = nullptr,
+                            PrefixIndex* courseNames = nullptr);
+
+    ResultSet searchStudents(const std::string& text);
+    ResultSet searchCourses(const std::string& text);
+
+    // Retournent l'ID choisi, -1 si l'opérateur annule (Entrée vide)
+    int selectStudent();
+    int selectCourse();
+    int selectGrade();   // choisit l'étudiant, puis une de ses notes
+};
+
+#endif // SELECTOR_H
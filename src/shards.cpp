@@ -0,0 +1,432 @@
+#include "shards.h"
+#include "dates.h"
+#include "table.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iterator>
+#include <map>
+#include <thread>
+#include <tuple>
+
+namespace {
+
+// Même ordre que la liste des notes Admin (GRADES_PAGE)
+const std::string GRADES_LISTING_SQL =
+    "SELECT g.id, s.id AS sid, s.name AS student, c.name AS course, g.grade, "
+    + daySql("g.date_recorded") + " AS date_recorded "
+    "FROM students s "
+    "CROSS JOIN grades g ON g.student_id = s.id "
+    "JOIN courses  c ON g.course_id  = c.id "
+    "ORDER BY s.name, s.id, c.name, g.id LIMIT ?";
+
+const char* COURSE_TOTALS_SQL =
+    "SELECT course_id, COUNT(*), SUM(grade), MIN(grade), MAX(grade) FROM grades GROUP BY course_id";
+
+// Sommes partielles d'un cours (un fichier, puis tous)
+struct CourseTotals {
+    long long count = 0;
+    double    sum   = 0;
+    double    min   = 0;
+    double    max   = 0;
+
+    void add(const CourseTotals& other) {
+        if (other.count == 0) return;
+        min    = count == 0 ? other.min : std::min(min, other.min);
+        max    = count == 0 ? other.max : std::max(max, other.max);
+        count += other.count;
+        sum   += other.sum;
+    }
+};
+
+std::string formatGrade(double value) {
+    char text[32];
+    std::snprintf(text, sizeof text, "%.2f", value);
+    return text;
+}
+
+} // namespace
+
+ShardedDatabase::ShardedDatabase(const std::string& basePath, size_t count) : basePath(basePath) {
+    for (size_t k = 0; k < std::max<size_t>(count, 1); ++k)
+        shards.push_back(std::make_unique<Shard>(shardPath(basePath, k)));
+}
+
+std::string ShardedDatabase::shardPath(const std::string& basePath, size_t shard) {
+    return basePath + ".shard" + std::to_string(shard);
+}
+
+size_t ShardedDatabase::size() const { return shards.size(); }
+
+size_t ShardedDatabase::shardOf(long long studentId) const {
+    auto n = static_cast<long long>(shards.size());
+    return static_cast<size_t>((studentId % n + n) % n);
+}
+
+Database& ShardedDatabase::shard(size_t k) { return shards[k]->db; }
+
+bool ShardedDatabase::open() {
+    for (auto& s : shards)
+        if (!s->db.isConnected() && !s->db.connect(false)) return false;
+    return true;
+}
+
+// ─── Répartition d'une base unique ─────────────────────────────────────────
+
+bool ShardedDatabase::split(Database& source) {
+    auto start = std::chrono::steady_clock::now();
+    for (auto& s : shards) {
+        s->db.disconnect();
+        for (const char* suffix : {"", "-wal", "-shm"})
+            std::remove((s->db.getPath() + suffix).c_str());
+        if (!s->db.connect(false)) return false;   // schéma complet, sans données de test
+    }
+
+    // Un writer par fichier : les copies avancent en parallèle
+    std::string src = source.escape(source.getPath());
+    std::string n   = std::to_string(shards.size());
+    std::vector<char> copied(shards.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t k = 0; k < shards.size(); ++k) {
+        workers.emplace_back([&, k]() {
+            Shard& s = *shards[k];
+            std::lock_guard<std::mutex> lock(s.writer);
+            std::string mine = " % " + n + " = " + std::to_string(k);
+            if (!s.db.execute("ATTACH DATABASE '" + src + "' AS src;")) return;
+            bool ok = s.db.begin()
+                && s.db.execute("INSERT INTO users SELECT * FROM src.users;")
+                && s.db.execute("INSERT INTO courses SELECT * FROM src.courses;")
+                && s.db.execute("INSERT INTO students SELECT * FROM src.students WHERE id" + mine + ";")
+                // L'historique de la source contient déjà la création de chaque note :
+                // trg_grades_history_ins la réécrirait (avec des IDs qui entrent en
+                // collision avec ceux recopiés). initSchema le recrée après la copie.
+                && s.db.execute("DROP TRIGGER IF EXISTS trg_grades_history_ins;")
+                && s.db.execute("INSERT INTO grades (id, student_id, course_id, grade, date_recorded) "
+                                "SELECT id, student_id, course_id, grade, date_recorded FROM src.grades "
+                                "WHERE student_id" + mine + " ORDER BY id;")
+                && s.db.execute("INSERT INTO results SELECT * FROM src.results WHERE student_id" + mine + ";")
+                && s.db.execute("INSERT INTO grade_history SELECT * FROM src.grade_history "
+                                "WHERE student_id" + mine + ";")
+                // Compteurs de la source : les nouveaux IDs dépassent tous ceux déjà attribués,
+                // y compris les IDs de notes recopiées dans un autre fichier
+                && s.db.execute("DELETE FROM sqlite_sequence WHERE name IN ('users', 'students', 'courses', 'grades');")
+                && s.db.execute("INSERT INTO sqlite_sequence (name, seq) SELECT name, seq FROM src.sqlite_sequence "
+                                "WHERE name IN ('users', 'students', 'courses', 'grades');");
+            if (ok) ok = s.db.commit();
+            else s.db.rollback();
+            s.db.execute("DETACH DATABASE src;");
+            if (ok) s.db.initSchema();
+            copied[k] = ok;
+        });
+    }
+    for (auto& w : workers) w.join();
+    if (std::find(copied.begin(), copied.end(), 0) != copied.end()) {
+        std::cerr << "✗ Répartition interrompue : fichiers incomplets.\n";
+        return false;
+    }
+
+    long long students = 0, grades = 0;
+    for (auto& s : shards) {
+        Statement count(s->db, "SELECT (SELECT COUNT(*) FROM students), (SELECT COUNT(*) FROM grades)");
+        if (!count.step()) return false;
+        std::cout << "  " << s->db.getPath() << " : " << count.getInt(0) << " étudiant(s), "
+                  << count.getInt(1) << " note(s)\n";
+        students += count.getInt(0);
+        grades   += count.getInt(1);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "✓ " << students << " étudiant(s) et " << grades << " note(s) répartis sur "
+              << shards.size() << " fichier(s) en " << std::fixed << std::setprecision(2)
+              << elapsed.count() << " s";
+    if (elapsed.count() > 0)
+        std::cout << " (" << std::setprecision(0) << (students + grades) / elapsed.count() << " lignes/s, "
+                  << shards.size() << " writer(s))";
+    std::cout << "\n";
+    return true;
+}
+
+// ─── Écritures routées ─────────────────────────────────────────────────────
+
+long long ShardedDatabase::nextId(size_t shard, const std::string& table) {
+    Statement last(shards[shard]->db,
+                   "SELECT MAX(IFNULL((SELECT MAX(id) FROM " + table + "), 0), "
+                   "IFNULL((SELECT seq FROM sqlite_sequence WHERE name = '" + table + "'), 0))");
+    if (!last.step()) return -1;
+    auto n  = static_cast<long long>(shards.size());
+    long long id = last.getInt(0) + 1;
+    return id + ((static_cast<long long>(shard) - id % n) % n + n) % n;
+}
+
+long long ShardedDatabase::addStudent(const std::string& name, const std::string& email,
+                                      const std::string& birthdate) {
+    size_t k = nextShard++ % shards.size();
+    Shard& s = *shards[k];
+    std::lock_guard<std::mutex> lock(s.writer);
+    if (!s.db.begin()) return -1;
+    long long id = nextId(k, "students");
+    Statement insert(s.db, "INSERT INTO students (id, name, email, birthdate) VALUES (?, ?, ?, ?)");
+    insert.bind(1, id);
+    insert.bind(2, name);
+    insert.bind(3, email);
+    insert.bind(4, birthdate);
+    if (id < 0 || !insert.run() || !s.db.commit()) { s.db.rollback(); return -1; }
+    return id;
+}
+
+long long ShardedDatabase::addCourse(const std::string& name, const std::string& description, int credits) {
+    // Tous les writers, toujours dans le même ordre : le cours a le même ID partout
+    std::vector<std::unique_lock<std::mutex>> locks;
+    for (auto& s : shards) locks.emplace_back(s->writer);
+
+    long long id = -1;
+    size_t begun = 0;
+    bool ok = true;
+    for (auto& s : shards) {
+        if (!(ok = s->db.begin())) break;
+        ++begun;
+        if (id < 0) {
+            Statement last(s->db, "SELECT MAX(IFNULL((SELECT MAX(id) FROM courses), 0), "
+                                  "IFNULL((SELECT seq FROM sqlite_sequence WHERE name = 'courses'), 0))");
+            if (!(ok = last.step())) break;
+            id = last.getInt(0) + 1;
+        }
+        Statement insert(s->db, "INSERT INTO courses (id, name, description, credits) VALUES (?, ?, ?, ?)");
+        insert.bind(1, id);
+        insert.bind(2, name);
+        insert.bind(3, description);
+        insert.bind(4, credits);
+        if (!(ok = insert.run())) break;
+    }
+    // Un COMMIT qui échoue après d'autres laisse le cours dans une partie des fichiers
+    for (size_t k = 0; k < begun; ++k) {
+        if (ok) ok = shards[k]->db.commit();
+        else shards[k]->db.rollback();
+    }
+    return ok ? id : -1;
+}
+
+long long ShardedDatabase::writeGrades(size_t shard, const std::vector<const ShardGrade*>& grades) {
+    Shard& s = *shards[shard];
+    std::lock_guard<std::mutex> lock(s.writer);
+    if (!s.db.begin()) return -1;
+    long long id = nextId(shard, "grades");
+    auto step = static_cast<long long>(shards.size());
+    Statement insert(s.db, "INSERT INTO grades (id, student_id, course_id, grade) VALUES (?, ?, ?, ?)");
+    for (const ShardGrade* g : grades) {
+        insert.bind(1, id);
+        insert.bind(2, g->studentId);
+        insert.bind(3, g->courseId);
+        insert.bind(4, g->grade);
+        if (id < 0 || !insert.run()) { s.db.rollback(); return -1; }
+        insert.reset();
+        id += step;
+    }
+    if (!s.db.commit()) { s.db.rollback(); return -1; }
+    return static_cast<long long>(grades.size());
+}
+
+long long ShardedDatabase::addGrades(const std::vector<ShardGrade>& grades) {
+    std::vector<std::vector<const ShardGrade*>> routed(shards.size());
+    for (const auto& g : grades) routed[shardOf(g.studentId)].push_back(&g);
+
+    std::vector<long long> written(shards.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t k = 0; k < shards.size(); ++k) {
+        if (routed[k].empty()) continue;
+        workers.emplace_back([&, k]() { written[k] = writeGrades(k, routed[k]); });
+    }
+    for (auto& w : workers) w.join();
+
+    long long total = 0;
+    for (long long n : written) {
+        if (n < 0) return -1;
+        total += n;
+    }
+    return total;
+}
+
+// ─── Lectures globales (fan-out puis fusion) ───────────────────────────────
+
+bool ShardedDatabase::fanOut(const std::function<bool(size_t, Database&)>& fn) const {
+    std::vector<char> done(shards.size(), 0);
+    std::vector<std::thread> workers;
+    for (size_t k = 0; k < shards.size(); ++k) {
+        workers.emplace_back([&, k]() {
+            Database reader(shards[k]->db.getPath());
+            done[k] = reader.connectReadOnly() && fn(k, reader);
+        });
+    }
+    for (auto& w : workers) w.join();
+    return std::find(done.begin(), done.end(), 0) == done.end();
+}
+
+ResultSet ShardedDatabase::listGrades(size_t limit) const {
+    // Chaque fichier renvoie ses limit premières lignes, déjà triées
+    struct Listed {
+        std::string student;
+        long long   sid;
+        std::string course;
+        long long   id;
+        Row         row;
+    };
+    std::vector<std::vector<Listed>> parts(shards.size());
+    bool ok = fanOut([&](size_t k, Database& reader) {
+        Statement stmt(reader, GRADES_LISTING_SQL);
+        stmt.bind(1, static_cast<long long>(limit));
+        while (stmt.step())
+            parts[k].push_back({stmt.getText(2), stmt.getInt(1), stmt.getText(3), stmt.getInt(0), stmt.getRow()});
+        return stmt.ok();
+    });
+    if (!ok) return {};
+
+    // Fusion : même ordre que ORDER BY (comparaison binaire des noms, comme SQLite)
+    std::vector<Listed> merged;
+    for (auto& part : parts)
+        std::move(part.begin(), part.end(), std::back_inserter(merged));
+    auto key = [](const Listed& l) { return std::tie(l.student, l.sid, l.course, l.id); };
+    size_t keep = std::min(limit, merged.size());
+    std::partial_sort(merged.begin(), merged.begin() + static_cast<std::ptrdiff_t>(keep), merged.end(),
+                      [&](const Listed& a, const Listed& b) { return key(a) < key(b); });
+
+    ResultSet rows;
+    for (size_t i = 0; i < keep; ++i) rows.push_back(std::move(merged[i].row));
+    return rows;
+}
+
+ResultSet ShardedDatabase::courseAverages() const {
+    std::vector<std::map<long long, CourseTotals>> parts(shards.size());
+    bool ok = fanOut([&](size_t k, Database& reader) {
+        Statement stmt(reader, COURSE_TOTALS_SQL);
+        while (stmt.step())
+            parts[k][stmt.getInt(0)] = {stmt.getInt(1), stmt.getDouble(2), stmt.getDouble(3), stmt.getDouble(4)};
+        return stmt.ok();
+    });
+    if (!ok) return {};
+
+    std::map<long long, CourseTotals> totals;
+    CourseTotals all;
+    for (auto& part : parts)
+        for (auto& [course, t] : part) {
+            totals[course].add(t);
+            all.add(t);
+        }
+
+    // Cours répliqués : les noms sont lus dans le premier fichier
+    ResultSet rows;
+    auto addRow = [&rows](const std::string& name, const CourseTotals& t) {
+        rows.push_back({{"course", name}, {"nb", std::to_string(t.count)},
+                        {"avg", formatGrade(t.sum / static_cast<double>(t.count))},
+                        {"min", formatGrade(t.min)}, {"max", formatGrade(t.max)}});
+    };
+    Statement names(shards[0]->db, "SELECT id, name FROM courses ORDER BY name");
+    while (names.step()) {
+        auto it = totals.find(names.getInt(0));
+        if (it != totals.end()) addRow(names.getText(1), it->second);
+    }
+    if (all.count > 0) addRow("Tous les cours", all);
+    return rows;
+}
+
+// ─── Banc d'essai des écritures routées ────────────────────────────────────
+
+namespace {
+
+constexpr std::array<Column, 5> WRITE_BENCH_COLUMNS = {{
+    {"Fichiers", "files", 10}, {"Étudiants", "students", 12}, {"Étudiants/s", "students_rate", 14},
+    {"Notes", "grades", 10}, {"Notes/s", "grades_rate", 12}}};
+
+struct WriteRates {
+    double students = 0;   // ajouts par seconde
+    double grades   = 0;
+};
+
+// Fichiers vides, puis écritures routées ; faux si une écriture a échoué
+bool measureWrites(const std::string& basePath, size_t count, size_t students, size_t gradesPerStudent,
+                   WriteRates& rates) {
+    for (size_t k = 0; k < count; ++k)
+        for (const char* suffix : {"", "-wal", "-shm"})
+            std::remove((ShardedDatabase::shardPath(basePath, k) + suffix).c_str());
+
+    bool ok = true;
+    {
+        ShardedDatabase bench(basePath, count);
+        if (!bench.open()) return false;
+
+        std::vector<long long> courses;
+        for (int c = 0; c < 8; ++c)
+            courses.push_back(bench.addCourse("Cours " + std::to_string(c + 1), "Banc d'essai", 3));
+        if (std::find(courses.begin(), courses.end(), -1) != courses.end()) ok = false;
+
+        // Un thread par fichier ; avec un seul fichier, ils attendent le même writer
+        std::vector<std::vector<long long>> ids(count);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> workers;
+        for (size_t t = 0; t < count && ok; ++t) {
+            workers.emplace_back([&, t]() {
+                for (size_t i = t; i < students; i += count) {
+                    std::string name = "Étudiant " + std::to_string(i);
+                    ids[t].push_back(bench.addStudent(name, "e" + std::to_string(i) + "@bench.fr", "2000-01-01"));
+                }
+            });
+        }
+        for (auto& w : workers) w.join();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        rates.students = elapsed.count() > 0 ? students / elapsed.count() : 0;
+
+        std::vector<ShardGrade> grades;
+        for (auto& part : ids)
+            for (long long id : part) {
+                if (id < 0) ok = false;
+                for (size_t g = 0; g < gradesPerStudent; ++g)
+                    grades.push_back({id, courses[(id + g) % courses.size()], static_cast<double>((id + g) % 21)});
+            }
+        if (ok) {
+            start = std::chrono::steady_clock::now();
+            ok = bench.addGrades(grades) == static_cast<long long>(grades.size());
+            elapsed = std::chrono::steady_clock::now() - start;
+            rates.grades = elapsed.count() > 0 ? grades.size() / elapsed.count() : 0;
+        }
+    }
+
+    for (size_t k = 0; k < count; ++k)
+        for (const char* suffix : {"", "-wal", "-shm"})
+            std::remove((ShardedDatabase::shardPath(basePath, k) + suffix).c_str());
+    return ok;
+}
+
+std::string formatRate(double value) {
+    char text[32];
+    std::snprintf(text, sizeof text, "%.0f", value);
+    return text;
+}
+
+} // namespace
+
+void benchmarkShardedWrites(const std::string& basePath, size_t count, size_t students,
+                            size_t gradesPerStudent) {
+    std::vector<size_t> configurations = {1};
+    if (count > 1) configurations.push_back(count);
+
+    ResultSet rows;
+    std::vector<WriteRates> measured;
+    for (size_t n : configurations) {
+        WriteRates rates;
+        if (!measureWrites(basePath, n, students, gradesPerStudent, rates)) {
+            std::cout << "✗ Écritures en échec sur " << n << " fichier(s), mesure abandonnée.\n";
+            return;
+        }
+        measured.push_back(rates);
+        rows.push_back({{"files", std::to_string(n)}, {"students", std::to_string(students)},
+                        {"students_rate", formatRate(rates.students)},
+                        {"grades", std::to_string(students * gradesPerStudent)},
+                        {"grades_rate", formatRate(rates.grades)}});
+    }
+
+    std::cout << "\nÉcritures routées, fichiers vides (" << basePath << ".shard<k>, supprimés ensuite)";
+    printTable(WRITE_BENCH_COLUMNS, rows);
+    if (measured.size() == 2 && measured[0].students > 0 && measured[0].grades > 0)
+        std::cout << "Accélération sur " << count << " fichiers : étudiants x" << std::fixed
+                  << std::setprecision(1) << measured[1].students / measured[0].students
+                  << ", notes x" << measured[1].grades / measured[0].grades << "\n";
+}
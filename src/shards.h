@@ -0,0 +1,91 @@
+#ifndef SHARDS_H
+#define SHARDS_H
+
+#include "database.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Note à écrire dans la base répartie
+struct ShardGrade {
+    long long studentId;
+    long long courseId;
+    double    grade;
+};
+
+// Base répartie sur N fichiers SQLite, chacun avec son propre writer :
+//  - un étudiant et ses notes vivent dans le fichier id % N ;
+//  - cours et comptes utilisateurs sont répliqués dans chaque fichier (mêmes IDs) ;
+//  - les IDs d'étudiants et de notes créés dans le fichier k valent k modulo N :
+//    uniques sur l'ensemble des fichiers sans compteur partagé entre eux.
+// Les écritures de fichiers différents avancent en parallèle ; les lectures globales
+// (liste des notes, moyennes) interrogent tous les fichiers en parallèle puis fusionnent.
+class ShardedDatabase {
+private:
+    struct Shard {
+        Database   db;
+        std::mutex writer;   // une transaction à la fois par fichier
+
+        explicit Shard(const std::string& path) : db(path) {}
+    };
+
+    std::string                         basePath;
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::atomic<size_t>                 nextShard{0};   // placement des nouveaux étudiants
+
+    // fn(k, reader) sur chaque fichier : un thread et une connexion en lecture seule par fichier.
+    // Faux si une connexion ou un appel a échoué.
+    bool fanOut(const std::function<bool(size_t, Database&)>& fn) const;
+
+    // Premier ID libre de table congru à shard modulo N (writer du fichier verrouillé)
+    long long nextId(size_t shard, const std::string& table);
+
+    // Notes d'un même fichier en une transaction ; retourne leur nombre (-1 : annulée)
+    long long writeGrades(size_t shard, const std::vector<const ShardGrade*>& grades);
+
+public:
+    ShardedDatabase(const std::string& basePath, size_t count);
+
+    // "student_management.db", 2 → "student_management.db.shard2"
+    static std::string shardPath(const std::string& basePath, size_t shard);
+
+    size_t    size() const;
+    size_t    shardOf(long long studentId) const;
+    Database& shard(size_t k);
+
+    // Ouvre les fichiers (créés vides s'ils n'existent pas ; schéma mis à niveau par connect())
+    bool open();
+
+    // (Re)crée les N fichiers à partir d'une base unique, un thread de copie par fichier.
+    // Résultats et historique des notes suivent leur étudiant ; le journal des changements
+    // de chaque fichier commence à sa copie.
+    bool split(Database& source);
+
+    // Écritures routées, appelables depuis plusieurs threads. Retournent l'ID créé, -1 en
+    // cas d'erreur.
+    long long addStudent(const std::string& name, const std::string& email, const std::string& birthdate);
+    long long addCourse(const std::string& name, const std::string& description, int credits);
+
+    // Notes regroupées par fichier, un writer et une transaction par fichier, en parallèle.
+    // Retourne le nombre de notes écrites ; un fichier en échec est annulé sans toucher
+    // aux autres (retour -1).
+    long long addGrades(const std::vector<ShardGrade>& grades);
+
+    // Liste globale des notes, dans l'ordre de la liste Admin (étudiant, cours, ID), tronquée à limit
+    ResultSet listGrades(size_t limit) const;
+
+    // Moyenne, nombre de notes, minimum et maximum par cours, puis toutes notes confondues
+    // (ligne "Tous les cours") ; sommes partielles de chaque fichier additionnées
+    ResultSet courseAverages() const;
+};
+
+// Écritures routées sur 1 fichier puis sur count fichiers, à partir de fichiers vides
+// basePath.shard<k> (supprimés ensuite) : étudiants ajoutés par count threads (une transaction
+// chacun), puis gradesPerStudent notes par étudiant en un appel à addGrades
+void benchmarkShardedWrites(const std::string& basePath, size_t count, size_t students,
+                            size_t gradesPerStudent);
+
+#endif // SHARDS_H
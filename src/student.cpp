@@ -1,4 +1,9 @@
 #include "student.h"
+#include "dates.h"
+#include "records.h"
+#include "results.h"
+#include "table.h"
+#include "filemanager.h"
 #include <iostream>
 #include <iomanip>
 #include <numeric>
@@ -7,6 +12,9 @@ Student::Student(int userId, const std::string& username, const std::string& pas
                  Database& db, int studentId)
     : User(userId, username, password, Role::STUDENT), db(db), studentId(studentId) {}
 
+static constexpr std::array<Column, 3> GRADE_COLUMNS = {{
+    {"Cours", "course", 30}, {"Note", "grade", 8}, {"Date", "date_recorded", 12}}};
+
 void Student::showMenu() {
     int choice = 0;
     do {
@@ -16,6 +24,7 @@ void Student::showMenu() {
         std::cout << "  [1] Mes informations\n";
         std::cout << "  [2] Mes notes\n";
         std::cout << "  [3] Ma moyenne générale\n";
+        std::cout << "  [4] Exporter mes données\n";
         std::cout << "  [0] Déconnexion\n";
         std::cout << "------------------------------\n";
         std::cout << "Choix : ";
@@ -26,6 +35,7 @@ void Student::showMenu() {
             case 1: viewMyInfo();    break;
             case 2: viewMyGrades();  break;
             case 3: viewMyAverage(); break;
+            case 4: FileManager(db).exportData(*this, studentId); break;
             case 0: std::cout << "Déconnexion...\n"; break;
             default: std::cout << "Option invalide.\n";
         }
@@ -33,26 +43,23 @@ void Student::showMenu() {
 }
 
 void Student::viewMyInfo() {
-    auto rows = db.query(
-        "SELECT name, email, birthdate FROM students WHERE id=" + std::to_string(studentId));
-
-    if (rows.empty()) {
+    auto student = StudentRepository(db).find(studentId);
+    if (!student) {
         std::cout << "Informations introuvables.\n";
         return;
     }
 
-    auto& row = rows[0];
     std::cout << "\n===== MES INFORMATIONS =====\n";
-    std::cout << "  Nom       : " << row["name"]      << "\n";
-    std::cout << "  Email     : " << row["email"]     << "\n";
-    std::cout << "  Naissance : " << row["birthdate"] << "\n";
+    std::cout << "  Nom       : " << student->name      << "\n";
+    std::cout << "  Email     : " << student->email     << "\n";
+    std::cout << "  Naissance : " << student->birthdate << "\n";
     std::cout << "  Login     : " << username          << "\n";
     std::cout << "============================\n";
 }
 
 void Student::viewMyGrades() {
     auto rows = db.query(
-        "SELECT c.name AS course, g.grade, g.date_recorded "
+        "SELECT c.name AS course, g.grade, " + daySql("g.date_recorded") + " AS date_recorded "
         "FROM grades g "
         "JOIN courses c ON g.course_id = c.id "
         "WHERE g.student_id = " + std::to_string(studentId) +
@@ -64,37 +71,17 @@ void Student::viewMyGrades() {
     }
 
     std::cout << "\n===== MES NOTES =====\n";
-    std::cout << std::left
-              << std::setw(30) << "Cours"
-              << std::setw(8)  << "Note"
-              << std::setw(12) << "Date" << "\n";
-    std::cout << std::string(50, '-') << "\n";
-
-    for (auto& row : rows) {
-        std::cout << std::left
-                  << std::setw(30) << row["course"]
-                  << std::setw(8)  << row["grade"]
-                  << std::setw(12) << row["date_recorded"] << "\n";
-    }
+    printTable(GRADE_COLUMNS, rows);
 }
 
 void Student::viewMyAverage() {
-    auto rows = db.query(
-        "SELECT AVG(grade) AS avg FROM grades WHERE student_id=" + std::to_string(studentId));
-
-    if (rows.empty() || rows[0]["avg"] == "NULL") {
+    // Moyenne pondérée par les crédits ECTS de chaque cours
+    auto avg = GradeRepository(db).weightedAverage(studentId);
+    if (!avg) {
         std::cout << "Aucune note pour calculer la moyenne.\n";
         return;
     }
 
-    double avg = std::stod(rows[0]["avg"]);
-    std::cout << "\nMoyenne générale : " << std::fixed << std::setprecision(2) << avg << " / 20\n";
-
-    // Mention
-    std::cout << "Mention : ";
-    if (avg >= 16)       std::cout << "Très Bien\n";
-    else if (avg >= 14)  std::cout << "Bien\n";
-    else if (avg >= 12)  std::cout << "Assez Bien\n";
-    else if (avg >= 10)  std::cout << "Passable\n";
-    else                 std::cout << "Insuffisant\n";
+    std::cout << "\nMoyenne générale (pondérée) : " << std::fixed << std::setprecision(2) << *avg << " / 20\n";
+    std::cout << "Mention : " << mentionFor(*avg) << "\n";
 }
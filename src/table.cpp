@@ -0,0 +1,63 @@
+#include "table.h"
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+// ─── Benchmark ─────────────────────────────────────────────────────────────
+
+static constexpr std::array<Column, 5> BENCH_COLUMNS = {{
+    {"ID", "id", 8}, {"Étudiant", "student", 25}, {"Cours", "course", 25},
+    {"Note", "grade", 8}, {"Date", "date", 12}}};
+
+void benchmarkTableRenderer(size_t rows, bool toStdout) {
+#ifdef _WIN32
+    const char* nullDevice = "NUL";
+#else
+    const char* nullDevice = "/dev/null";
+#endif
+    const std::string names[] = {"Élodie Martin", "Jérôme Dubois", "Anaïs Leroy", "Bob Dupuis"};
+    const std::string courses[] = {"Algorithmique", "Bases de donnees", "Programmation C++"};
+
+    // 1) Version historique : std::setw sur un flux, cellule par cellule
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream nullStream;
+        if (!toStdout) nullStream.open(nullDevice);
+        std::ostream& os = toStdout ? std::cout : nullStream;
+        for (size_t i = 0; i < rows; ++i) {
+            os << std::left << std::setw(8) << i
+               << std::setw(25) << names[i % 4]
+               << std::setw(25) << courses[i % 3]
+               << std::setw(8)  << "14.5"
+               << std::setw(12) << "2024-06-30" << "\n";
+        }
+        os.flush();
+    }
+    std::chrono::duration<double> streamTime = std::chrono::steady_clock::now() - start;
+
+    // 2) TableRenderer : formatage en mémoire, écriture par blocs
+    start = std::chrono::steady_clock::now();
+    {
+        FILE* target = toStdout ? stdout : std::fopen(nullDevice, "w");
+        if (!target) { std::cerr << "✗ Impossible d'ouvrir " << nullDevice << "\n"; return; }
+        {
+            TableRenderer<5> table(BENCH_COLUMNS, target);
+            char id[24];
+            for (size_t i = 0; i < rows; ++i) {
+                auto end = std::to_chars(id, id + sizeof id, i).ptr;
+                table.row({std::string_view(id, static_cast<size_t>(end - id)), names[i % 4],
+                           courses[i % 3], "14.5", "2024-06-30"});
+            }
+        }
+        if (!toStdout) std::fclose(target);
+    }
+    std::chrono::duration<double> bufferTime = std::chrono::steady_clock::now() - start;
+
+    std::cout << "\n" << rows << " lignes vers " << (toStdout ? "stdout" : nullDevice) << " :\n"
+              << std::fixed << std::setprecision(3)
+              << "  std::setw / iostream : " << streamTime.count() << " s\n"
+              << "  TableRenderer        : " << bufferTime.count() << " s (x"
+              << std::setprecision(1) << streamTime.count() / bufferTime.count() << ")\n";
+}
@@ -0,0 +1,72 @@
+#ifndef TABLE_H
+#define TABLE_H
+
+#include "database.h"
+#include "outputbuffer.h"
+#include <array>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+// Colonne d'un tableau : en-tête, nom de la colonne SQL (clé du Row) et largeur d'affichage
+struct Column {
+    const char* header;
+    const char* key;
+    int         width;
+};
+
+// Largeur totale d'un tableau, calculée à la compilation (ligne de séparation)
+template <size_t N>
+constexpr int tableWidth(const std::array<Column, N>& columns) {
+    int total = 0;
+    for (const auto& c : columns) total += c.width;
+    return total;
+}
+
+// Affichage d'un tableau dont les colonnes sont fixées à la compilation
+template <size_t N>
+class TableRenderer {
+private:
+    const std::array<Column, N>& columns;
+    OutputBuffer                 out;
+
+public:
+    explicit TableRenderer(const std::array<Column, N>& columns, FILE* target = stdout)
+        : columns(columns), out(target) {}
+
+    void header() {
+        out.append('\n');
+        for (const auto& c : columns) out.cell(c.header, c.width);
+        out.append('\n');
+        out.append('-', tableWidth(columns));
+        out.append('\n');
+    }
+
+    void row(const std::array<std::string_view, N>& cells) {
+        for (size_t i = 0; i < N; ++i) out.cell(cells[i], columns[i].width);
+        out.append('\n');
+    }
+
+    void row(const Row& values) {
+        for (const auto& c : columns) {
+            auto it = values.find(c.key);
+            out.cell(it == values.end() ? std::string_view() : std::string_view(it->second), c.width);
+        }
+        out.append('\n');
+    }
+
+    void flush() { out.flush(); }
+};
+
+// En-tête + toutes les lignes, en une passe
+template <size_t N>
+void printTable(const std::array<Column, N>& columns, const ResultSet& rows) {
+    TableRenderer<N> table(columns);
+    table.header();
+    for (const auto& r : rows) table.row(r);
+}
+
+// Compare std::setw / std::cout et TableRenderer sur un nombre de lignes synthétiques
+void benchmarkTableRenderer(size_t rows, bool toStdout);
+
+#endif // TABLE_H
@@ -0,0 +1,248 @@
+#include "transcripts.h"
+#include "outputbuffer.h"
+#include "results.h"
+#include "table.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace {
+
+constexpr std::array<Column, 6> TRANSCRIPT_COLUMNS = {{
+    {"Cours", "course", 28}, {"Crédits", "credits", 9}, {"Notes", "grades", 30},
+    {"Moyenne", "average", 9}, {"Meilleure", "best", 11}, {"Validé", "passed", 6}}};
+
+const char* STUDENTS_RANGE_SQL =
+    "SELECT id, name, email, birthdate FROM students WHERE id BETWEEN ?1 AND ?2 ORDER BY id";
+
+// Même ordre que les étudiants : l'index idx_grades_student (ou la clé primaire en
+// disposition groupée) fournit les notes étudiant par étudiant, cours par cours, sans tri
+const char* GRADES_RANGE_SQL =
+    "SELECT g.student_id, g.course_id, c.name, c.credits, g.grade "
+    "FROM grades g "
+    "JOIN courses c ON g.course_id = c.id "
+    "WHERE g.student_id BETWEEN ?1 AND ?2 "
+    "ORDER BY g.student_id, g.course_id";
+
+// Ligne du relevé : toutes les notes d'un étudiant dans un cours
+struct CourseLine {
+    std::string name;
+    int         credits = 0;
+    std::string grades;      // "14.50 12.00"
+    double      sum     = 0;
+    int         count   = 0;
+    double      best    = 0;
+};
+
+std::string formatGrade(double value) {
+    char text[32];
+    std::snprintf(text, sizeof text, "%.2f", value);
+    return text;
+}
+
+// Écrit un relevé ; false si le fichier n'a pas pu être écrit en entier
+bool writeTranscript(const std::string& path, const Statement& student, const std::vector<CourseLine>& courses,
+                     const StudentResult& result, bool graded) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+    bool ok;
+    {
+        OutputBuffer out(file, 1 << 12);
+        out.append("=== RELEVE DE NOTES ===\n");
+        out.append("Étudiant  : ");
+        out.append(student.getView(1));
+        out.append(" (n° " + std::to_string(result.studentId) + ")\nEmail     : ");
+        out.append(student.getView(2));
+        out.append("\nNaissance : ");
+        out.append(student.getView(3));
+        out.append("\n\n");
+
+        for (const auto& c : TRANSCRIPT_COLUMNS) out.cell(c.header, c.width);
+        out.append('\n');
+        out.append('-', tableWidth(TRANSCRIPT_COLUMNS));
+        out.append('\n');
+        for (const auto& course : courses) {
+            out.cell(course.name, TRANSCRIPT_COLUMNS[0].width);
+            out.cell(std::to_string(course.credits), TRANSCRIPT_COLUMNS[1].width);
+            out.cell(course.grades, TRANSCRIPT_COLUMNS[2].width);
+            out.cell(formatGrade(course.sum / course.count), TRANSCRIPT_COLUMNS[3].width);
+            out.cell(formatGrade(course.best), TRANSCRIPT_COLUMNS[4].width);
+            out.append(course.best >= PASS_THRESHOLD ? "oui\n" : "non\n");
+        }
+        if (courses.empty()) out.append("Aucune note.\n");
+
+        out.append("\nMoyenne pondérée : ");
+        out.append(graded ? formatGrade(result.weightedAvg) + " / 20" : std::string("-"));
+        out.append("\nMention          : ");
+        out.append(graded ? mentionFor(result.weightedAvg) : std::string("-"));
+        out.append("\nCrédits ECTS     : " + std::to_string(result.creditsEarned) + " acquis, " +
+                   std::to_string(result.creditsOutstanding) + " restant(s)");
+        out.append("\nDécision         : ");
+        out.append(decisionFor(result));
+        out.append('\n');
+        out.flush();
+        ok = out.good();
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace
+
+TranscriptGenerator::TranscriptGenerator(Database& db) : db(db) {}
+
+void TranscriptGenerator::generateRange(Database& reader, const std::string& directory, int catalog,
+                                        Chunk& chunk) {
+    Statement students(reader, STUDENTS_RANGE_SQL);
+    Statement grades(reader, GRADES_RANGE_SQL);
+    if (!students.isValid() || !grades.isValid()) { chunk.failed = -1; return; }
+    students.bind(1, chunk.first);
+    students.bind(2, chunk.last);
+    grades.bind(1, chunk.first);
+    grades.bind(2, chunk.last);
+
+    std::vector<CourseLine> courses;
+    bool hasGrade = grades.step();
+    while (students.step()) {
+        long long id = students.getInt(0);
+
+        // Notes de l'étudiant courant, regroupées par cours
+        courses.clear();
+        long long lastCourse = -1;
+        while (hasGrade && grades.getInt(0) <= id) {
+            if (grades.getInt(0) == id) {
+                long long course = grades.getInt(1);
+                double    grade  = grades.getDouble(4);
+                if (course != lastCourse) {
+                    courses.emplace_back();
+                    courses.back().name    = grades.getText(2);
+                    courses.back().credits = static_cast<int>(grades.getInt(3));
+                    lastCourse = course;
+                }
+                CourseLine& line = courses.back();
+                if (line.count > 0) line.grades += ' ';
+                line.grades += formatGrade(grade);
+                line.sum  += grade;
+                line.best  = line.count == 0 ? grade : std::max(line.best, grade);
+                ++line.count;
+            }
+            hasGrade = grades.step();
+        }
+
+        // Même calcul que ResultsEngine : Σ note × crédits / Σ crédits
+        StudentResult result{};
+        result.studentId = static_cast<int>(id);
+        double    weighted = 0;
+        long long weight   = 0;
+        for (const auto& line : courses) {
+            weighted += line.sum * line.credits;
+            weight   += static_cast<long long>(line.count) * line.credits;
+            result.credits += line.credits;
+            if (line.best >= PASS_THRESHOLD) result.creditsEarned += line.credits;
+        }
+        bool graded = weight > 0;
+        result.weightedAvg        = graded ? weighted / static_cast<double>(weight) : 0;
+        result.creditsOutstanding = std::max(0, catalog - result.creditsEarned);
+
+        std::string name = "releve_" + std::to_string(id) + ".txt";
+        if (!writeTranscript(directory + "/" + name, students, courses, result, graded)) {
+            ++chunk.failed;
+            continue;
+        }
+        ++chunk.written;
+        chunk.index += std::to_string(id) + "|" + name + "|" +
+                       (graded ? formatGrade(result.weightedAvg) + "|" + mentionFor(result.weightedAvg)
+                               : std::string("|")) +
+                       "|" + decisionFor(result) + "\n";
+    }
+    if (!students.ok() || !grades.ok()) chunk.failed = -1;
+}
+
+long long TranscriptGenerator::generateAll(const std::string& directory) {
+    auto start = std::chrono::steady_clock::now();
+
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    if (error) {
+        std::cerr << "✗ Impossible de créer le répertoire " << directory << " : " << error.message() << "\n";
+        return -1;
+    }
+
+    // Tous les relevés décrivent le même état de la base
+    ReadSnapshot snapshot(db);
+    if (!snapshot.isValid()) {
+        std::cerr << "✗ Impossible d'ouvrir une transaction de lecture.\n";
+        return -1;
+    }
+
+    Statement bounds(db, "SELECT MIN(id), MAX(id), (SELECT IFNULL(SUM(credits), 0) FROM courses) FROM students");
+    if (!bounds.step() || bounds.isNull(0)) {
+        std::cout << "Aucun étudiant.\n";
+        return 0;
+    }
+    long long lo      = bounds.getInt(0);
+    long long hi      = bounds.getInt(1);
+    int       catalog = static_cast<int>(bounds.getInt(2));
+
+    // Découpage en tranches d'IDs : plus de tranches que de threads pour équilibrer
+    unsigned  nThreads = std::max(1u, std::thread::hardware_concurrency());
+    long long span     = hi - lo + 1;
+    long long nChunks  = std::min<long long>(span, nThreads * 8LL);
+    long long step     = (span + nChunks - 1) / nChunks;
+    std::vector<Chunk> chunks;
+    for (long long first = lo; first <= hi; first += step)
+        chunks.emplace_back(first, std::min(first + step - 1, hi));
+
+    // Un thread = une connexion en lecture seule rattachée à l'instantané
+    unsigned nWorkers = std::min<unsigned>(nThreads, static_cast<unsigned>(chunks.size()));
+    std::atomic<size_t> next{0};
+    std::vector<std::thread> workers;
+    for (unsigned t = 0; t < nWorkers; ++t) {
+        workers.emplace_back([&]() {
+            Database reader(db.getPath());
+            bool ready = reader.connectReadOnly() && snapshot.join(reader);
+            for (size_t i = next++; i < chunks.size(); i = next++) {
+                if (ready) generateRange(reader, directory, catalog, chunks[i]);
+                else chunks[i].failed = -1;
+            }
+            if (ready) reader.commit();
+        });
+    }
+    for (auto& w : workers) w.join();
+
+    // Manifeste : un relevé par ligne, dans l'ordre des IDs
+    long long written = 0, failed = 0;
+    bool aborted = false;
+    std::string manifest = directory + "/releves.manifest";
+    std::ofstream out(manifest);
+    out << "=== RELEVES DE NOTES ===\n";
+    out << "snapshot|" << snapshot.generation() << "|" << snapshot.takenAt() << "\n";
+    out << "id|fichier|moyenne|mention|decision\n";
+    for (auto& chunk : chunks) {
+        if (chunk.failed < 0) aborted = true;
+        else failed += chunk.failed;
+        written += chunk.written;
+        out << chunk.index;
+    }
+    out.close();
+    if (!out || aborted || failed > 0) {
+        std::cerr << "✗ Relevés incomplets : " << written << " écrit(s), " << failed
+                  << " fichier(s) en échec" << (aborted ? ", lecture interrompue" : "") << ".\n";
+        return -1;
+    }
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "  " << written << " relevé(s) en " << std::fixed << std::setprecision(2)
+              << elapsed.count() << " s, " << nWorkers << " thread(s)";
+    if (elapsed.count() > 0)
+        std::cout << " (" << std::setprecision(0) << written / elapsed.count() << " relevés/s)";
+    std::cout << "\n  Instantané : génération " << snapshot.generation()
+              << " (" << snapshot.takenAt() << ")\n✓ Relevés → " << manifest << "\n";
+    return written;
+}
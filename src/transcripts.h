@@ -0,0 +1,38 @@
+#ifndef TRANSCRIPTS_H
+#define TRANSCRIPTS_H
+
+#include "database.h"
+#include <string>
+
+// Relevés de notes de fin de semestre : un fichier texte par étudiant (informations,
+// notes par cours, moyenne pondérée, mention, crédits ECTS et décision), comme
+// exportStudentInfo mais pour toute la promotion
+class TranscriptGenerator {
+private:
+    Database& db;
+
+    // Tranche d'IDs d'étudiants traitée d'un bloc par un thread
+    struct Chunk {
+        long long   first;
+        long long   last;
+        long long   written = 0;
+        long long   failed  = 0;
+        std::string index;        // lignes du manifeste, dans l'ordre des IDs
+
+        Chunk(long long first, long long last) : first(first), last(last) {}
+    };
+
+    // Travail d'un thread : deux requêtes préparées parcourues en parallèle (étudiants
+    // et notes, toutes deux dans l'ordre des IDs d'étudiants), un fichier par étudiant
+    static void generateRange(Database& reader, const std::string& directory, int catalog, Chunk& chunk);
+
+public:
+    explicit TranscriptGenerator(Database& db);
+
+    // Écrit directory/releve_<id>.txt pour chaque étudiant et directory/releves.manifest.
+    // Tous les threads lisent le même instantané de la base.
+    // Retourne le nombre de relevés écrits, -1 en cas d'erreur.
+    long long generateAll(const std::string& directory);
+};
+
+#endif // TRANSCRIPTS_H